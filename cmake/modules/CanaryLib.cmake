@@ -64,7 +64,7 @@ target_link_libraries(${PROJECT_NAME}_lib
         ${LUAJIT_LIBRARIES}
         CURL::libcurl
         ZLIB::ZLIB
-        absl::any absl::log absl::base absl::bits
+        absl::any absl::log absl::base absl::bits absl::inlined_vector
         asio::asio
         eventpp::eventpp
         fmt::fmt
@@ -19,6 +19,7 @@
 #include "game/scheduling/dispatcher.hpp"
 #include "game/scheduling/events_scheduler.hpp"
 #include "io/iomarket.hpp"
+#include "io/iohighscores.hpp"
 #include "lib/thread/thread_pool.hpp"
 #include "lua/creature/events.hpp"
 #include "lua/modules/modules.hpp"
@@ -71,6 +72,7 @@ int CanaryServer::run() {
 
 			IOMarket::checkExpiredOffers();
 			IOMarket::getInstance().updateStatistics();
+			g_ioHighscores().load();
 
 			logger.info("Loaded all modules, server starting up...");
 
@@ -363,5 +365,6 @@ void CanaryServer::modulesLoadHelper(bool loaded, std::string moduleName) {
 }
 
 void CanaryServer::shutdown() {
+	g_dispatcher().shutdown();
 	inject<ThreadPool>().shutdown();
 }
\ No newline at end of file
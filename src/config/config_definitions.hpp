@@ -51,6 +51,7 @@ enum booleanConfig_t {
 	SORT_LOOT_BY_CHANCE,
 	TOGGLE_SAVE_INTERVAL,
 	TOGGLE_SAVE_INTERVAL_CLEAN_MAP,
+	TOGGLE_SAVE_ASYNC,
 	PREY_ENABLED,
 	PREY_FREE_THIRD_SLOT,
 	TASK_HUNTING_ENABLED,
@@ -127,6 +128,7 @@ enum stringConfig_t {
 
 enum integerConfig_t {
 	SQL_PORT,
+	SQL_POOL_SIZE,
 	MAX_PLAYERS,
 	PZ_LOCKED,
 	DEFAULT_DESPAWNRANGE,
@@ -181,6 +183,8 @@ enum integerConfig_t {
 	STAMINA_PZ_GAIN,
 	STAMINA_TRAINER_GAIN,
 	SAVE_INTERVAL_TIME,
+	SAVE_ASYNC_WINDOW,
+	HIGHSCORES_REFRESH_INTERVAL,
 	PREY_REROLL_PRICE_LEVEL,
 	PREY_SELECTION_LIST_PRICE,
 	PREY_BONUS_TIME,
@@ -120,6 +120,7 @@ bool ConfigManager::load() {
 		boolean[RESET_SESSIONS_ON_STARTUP] = getGlobalBoolean(L, "resetSessionsOnStartup", false);
 
 		integer[SQL_PORT] = getGlobalNumber(L, "mysqlPort", 3306);
+		integer[SQL_POOL_SIZE] = getGlobalNumber(L, "mysqlPoolSize", 4);
 		integer[GAME_PORT] = getGlobalNumber(L, "gameProtocolPort", 7172);
 		integer[LOGIN_PORT] = getGlobalNumber(L, "loginProtocolPort", 7171);
 		integer[STATUS_PORT] = getGlobalNumber(L, "statusProtocolPort", 7171);
@@ -177,6 +178,7 @@ bool ConfigManager::load() {
 	boolean[SORT_LOOT_BY_CHANCE] = getGlobalBoolean(L, "sortLootByChance", false);
 	boolean[TOGGLE_SAVE_INTERVAL] = getGlobalBoolean(L, "toggleSaveInterval", false);
 	boolean[TOGGLE_SAVE_INTERVAL_CLEAN_MAP] = getGlobalBoolean(L, "toggleSaveIntervalCleanMap", false);
+	boolean[TOGGLE_SAVE_ASYNC] = getGlobalBoolean(L, "toggleSaveAsync", false);
 	boolean[TELEPORT_SUMMONS] = getGlobalBoolean(L, "teleportSummons", false);
 	boolean[ALLOW_RELOAD] = getGlobalBoolean(L, "allowReload", false);
 
@@ -256,6 +258,8 @@ bool ConfigManager::load() {
 	integer[STAMINA_TRAINER_DELAY] = getGlobalNumber(L, "staminaTrainerDelay", 5);
 	integer[STAMINA_TRAINER_GAIN] = getGlobalNumber(L, "staminaTrainerGain", 1);
 	integer[SAVE_INTERVAL_TIME] = getGlobalNumber(L, "saveIntervalTime", 1);
+	integer[SAVE_ASYNC_WINDOW] = getGlobalNumber(L, "saveAsyncWindow", 0);
+	integer[HIGHSCORES_REFRESH_INTERVAL] = getGlobalNumber(L, "highscoresRefreshInterval", 300);
 	integer[MAX_ALLOWED_ON_A_DUMMY] = getGlobalNumber(L, "maxAllowedOnADummy", 1);
 	integer[FREE_QUEST_STAGE] = getGlobalNumber(L, "freeQuestStage", 1);
 	integer[DEPOTCHEST] = getGlobalNumber(L, "depotChest", 4);
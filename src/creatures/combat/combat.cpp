@@ -18,6 +18,7 @@
 #include "creatures/monsters/monster.hpp"
 #include "creatures/monsters/monsters.hpp"
 #include "items/weapons/weapons.hpp"
+#include "map/utils/sightmask.hpp"
 
 int32_t Combat::getLevelFormula(const Player* player, const std::shared_ptr<Spell> &wheelSpell, const CombatDamage &damage) const {
 	if (!player) {
@@ -99,13 +100,13 @@ CombatDamage Combat::getCombatDamage(Creature* creature, Creature* target) const
 	return damage;
 }
 
-void Combat::getCombatArea(const Position &centerPos, const Position &targetPos, const AreaCombat* area, std::forward_list<Tile*> &list) {
+void Combat::getCombatArea(const Position &centerPos, const Position &targetPos, const AreaCombat* area, std::forward_list<Tile*> &list, std::vector<Position> &emptyPositions) {
 	if (targetPos.z >= MAP_MAX_LAYERS) {
 		return;
 	}
 
 	if (area) {
-		area->getList(centerPos, targetPos, list);
+		area->getList(centerPos, targetPos, list, emptyPositions);
 	} else {
 		list.push_front(g_game().map.getOrCreateTile(targetPos));
 	}
@@ -834,14 +835,18 @@ void Combat::combatTileEffects(const SpectatorHashSet &spectators, Creature* cas
 		params.tileCallback->onTileCombat(caster, tile);
 	}
 
+	combatPositionEffects(spectators, caster, tile->getPosition(), params);
+}
+
+void Combat::combatPositionEffects(const SpectatorHashSet &spectators, Creature* caster, const Position &position, const CombatParams &params) {
 	if (params.impactEffect != CONST_ME_NONE) {
-		Game::addMagicEffect(spectators, tile->getPosition(), params.impactEffect);
+		Game::addMagicEffect(spectators, position, params.impactEffect);
 	}
 
 	if (params.soundImpactEffect != SoundEffect_t::SILENCE) {
-		g_game().sendDoubleSoundEffect(tile->getPosition(), params.soundCastEffect, params.soundImpactEffect, caster);
+		g_game().sendDoubleSoundEffect(position, params.soundCastEffect, params.soundImpactEffect, caster);
 	} else if (params.soundCastEffect != SoundEffect_t::SILENCE) {
-		g_game().sendSingleSoundEffect(tile->getPosition(), params.soundCastEffect, caster);
+		g_game().sendSingleSoundEffect(position, params.soundCastEffect, caster);
 	}
 }
 
@@ -988,11 +993,12 @@ bool Combat::doCombat(Creature* caster, const Position &position) const {
 
 void Combat::CombatFunc(Creature* caster, const Position &origin, const Position &pos, const AreaCombat* area, const CombatParams &params, CombatFunction func, CombatDamage* data) {
 	std::forward_list<Tile*> tileList;
+	std::vector<Position> emptyPositions;
 
 	if (caster) {
-		getCombatArea(caster->getPosition(), pos, area, tileList);
+		getCombatArea(caster->getPosition(), pos, area, tileList, emptyPositions);
 	} else {
-		getCombatArea(pos, pos, area, tileList);
+		getCombatArea(pos, pos, area, tileList, emptyPositions);
 	}
 
 	SpectatorHashSet spectators;
@@ -1013,6 +1019,10 @@ void Combat::CombatFunc(Creature* caster, const Position &origin, const Position
 			maxY = diff;
 		}
 	}
+	for (const Position &emptyPos : emptyPositions) {
+		maxX = std::max<uint32_t>(maxX, Position::getDistanceX(emptyPos, pos));
+		maxY = std::max<uint32_t>(maxY, Position::getDistanceY(emptyPos, pos));
+	}
 
 	const int32_t rangeX = maxX + MAP_MAX_VIEW_PORT_X;
 	const int32_t rangeY = maxY + MAP_MAX_VIEW_PORT_Y;
@@ -1110,6 +1120,13 @@ void Combat::CombatFunc(Creature* caster, const Position &origin, const Position
 		combatTileEffects(spectators, caster, tile, params);
 	}
 
+	// Nothing to hit there, only the effects are shown, unless the caster is on another floor
+	if (!caster || caster->getPosition().z == pos.z) {
+		for (const Position &emptyPos : emptyPositions) {
+			combatPositionEffects(spectators, caster, emptyPos, params);
+		}
+	}
+
 	// Wheel of destiny update beam mastery damage
 	if (casterPlayer) {
 		casterPlayer->wheel()->updateBeamMasteryDamage(tmpDamage, beamAffectedTotal, beamAffectedCurrent);
@@ -1751,7 +1768,7 @@ AreaCombat::AreaCombat(const AreaCombat &rhs) {
 	}
 }
 
-void AreaCombat::getList(const Position &centerPos, const Position &targetPos, std::forward_list<Tile*> &list) const {
+void AreaCombat::getList(const Position &centerPos, const Position &targetPos, std::forward_list<Tile*> &list, std::vector<Position> &emptyPositions) const {
 	const MatrixArea* area = getArea(centerPos, targetPos);
 	if (!area) {
 		return;
@@ -1760,17 +1777,35 @@ void AreaCombat::getList(const Position &centerPos, const Position &targetPos, s
 	uint32_t centerY, centerX;
 	area->getCenter(centerY, centerX);
 
-	Position tmpPos(targetPos.x - centerX, targetPos.y - centerY, targetPos.z);
-	uint32_t cols = area->getCols();
-	for (uint32_t y = 0, rows = area->getRows(); y < rows; ++y) {
-		for (uint32_t x = 0; x < cols; ++x) {
-			if (area->getValue(y, x) != 0 && g_game().isSightClear(targetPos, tmpPos, true)) {
-				list.push_front(g_game().map.getOrCreateTile(tmpPos));
+	// The area clipped to the map, it always holds targetPos and so every sight line from it
+	const int32_t left = std::max<int32_t>(0, static_cast<int32_t>(targetPos.x) - static_cast<int32_t>(centerX));
+	const int32_t top = std::max<int32_t>(0, static_cast<int32_t>(targetPos.y) - static_cast<int32_t>(centerY));
+	const int32_t right = std::min<int32_t>(std::numeric_limits<uint16_t>::max(), static_cast<int32_t>(targetPos.x) - static_cast<int32_t>(centerX) + static_cast<int32_t>(area->getCols()) - 1);
+	const int32_t bottom = std::min<int32_t>(std::numeric_limits<uint16_t>::max(), static_cast<int32_t>(targetPos.y) - static_cast<int32_t>(centerY) + static_cast<int32_t>(area->getRows()) - 1);
+
+	// Game thread only, reused so big areas don't allocate on every cast
+	static SightMask sightMask;
+	sightMask.build(g_game().map, Position(left, top, targetPos.z), right - left + 1, bottom - top + 1);
+
+	const int32_t offsetX = static_cast<int32_t>(targetPos.x) - static_cast<int32_t>(centerX);
+	const int32_t offsetY = static_cast<int32_t>(targetPos.y) - static_cast<int32_t>(centerY);
+	for (int32_t y = top; y <= bottom; ++y) {
+		for (int32_t x = left; x <= right; ++x) {
+			if (area->getValue(y - offsetY, x - offsetX) == 0) {
+				continue;
+			}
+
+			const Position tmpPos(x, y, targetPos.z);
+			if (!sightMask.isSightClear(targetPos, tmpPos)) {
+				continue;
+			}
+
+			if (Tile* tile = g_game().map.getTile(tmpPos)) {
+				list.push_front(tile);
+			} else {
+				emptyPositions.push_back(tmpPos);
 			}
-			tmpPos.x++;
 		}
-		tmpPos.x -= cols;
-		tmpPos.y++;
 	}
 }
 
@@ -197,7 +197,11 @@ public:
 	// non-assignable
 	AreaCombat &operator=(const AreaCombat &) = delete;
 
-	void getList(const Position &centerPos, const Position &targetPos, std::forward_list<Tile*> &list) const;
+	/**
+	 * Collects the tiles of the area in sight of targetPos. Positions of the area
+	 * in sight without a tile go to emptyPositions instead of creating one.
+	 */
+	void getList(const Position &centerPos, const Position &targetPos, std::forward_list<Tile*> &list, std::vector<Position> &emptyPositions) const;
 
 	void setupArea(const std::list<uint32_t> &list, uint32_t rows);
 	void setupArea(int32_t length, int32_t spread);
@@ -268,7 +272,7 @@ public:
 	static void doCombatDispel(Creature* caster, Creature* target, const CombatParams &params);
 	static void doCombatDispel(Creature* caster, const Position &position, const AreaCombat* area, const CombatParams &params);
 
-	static void getCombatArea(const Position &centerPos, const Position &targetPos, const AreaCombat* area, std::forward_list<Tile*> &list);
+	static void getCombatArea(const Position &centerPos, const Position &targetPos, const AreaCombat* area, std::forward_list<Tile*> &list, std::vector<Position> &emptyPositions);
 
 	static bool isInPvpZone(const Creature* attacker, const Creature* target);
 	static bool isProtected(const Player* attacker, const Player* target);
@@ -357,6 +361,7 @@ private:
 	static void CombatNullFunc(Creature* caster, Creature* target, const CombatParams &params, CombatDamage* data);
 
 	static void combatTileEffects(const SpectatorHashSet &spectators, Creature* caster, Tile* tile, const CombatParams &params);
+	static void combatPositionEffects(const SpectatorHashSet &spectators, Creature* caster, const Position &position, const CombatParams &params);
 
 	/**
 	 * @brief Calculate the level formula for combat.
@@ -18,6 +18,66 @@
  *  Condition
  */
 
+namespace {
+	// Sizes are rounded up to a multiple of this, conditions bigger than the last class use the heap directly
+	constexpr size_t CONDITION_SIZE_STEP = 64;
+	constexpr size_t CONDITION_SIZE_CLASSES = 16;
+	// Per size class and thread, blocks above this count go back to the heap
+	constexpr size_t MAX_CACHED_CONDITIONS = 1024;
+
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+
+	struct ConditionCache {
+		std::array<FreeBlock*, CONDITION_SIZE_CLASSES> heads = {};
+		std::array<size_t, CONDITION_SIZE_CLASSES> sizes = {};
+
+		~ConditionCache() {
+			for (FreeBlock* &head : heads) {
+				while (head) {
+					::operator delete(std::exchange(head, head->next));
+				}
+			}
+		}
+	};
+
+	thread_local ConditionCache conditionCache;
+
+	constexpr size_t getSizeClass(size_t size) {
+		return (size - 1) / CONDITION_SIZE_STEP;
+	}
+}
+
+void* Condition::operator new(size_t size) {
+	const size_t sizeClass = getSizeClass(size);
+	if (sizeClass >= CONDITION_SIZE_CLASSES) {
+		return ::operator new(size);
+	}
+
+	FreeBlock* &head = conditionCache.heads[sizeClass];
+	if (head) {
+		--conditionCache.sizes[sizeClass];
+		return std::exchange(head, head->next);
+	}
+	return ::operator new((sizeClass + 1) * CONDITION_SIZE_STEP);
+}
+
+void Condition::operator delete(void* block, size_t size) {
+	if (!block) {
+		return;
+	}
+
+	const size_t sizeClass = getSizeClass(size);
+	if (sizeClass >= CONDITION_SIZE_CLASSES || conditionCache.sizes[sizeClass] >= MAX_CACHED_CONDITIONS) {
+		::operator delete(block);
+		return;
+	}
+
+	conditionCache.heads[sizeClass] = ::new (block) FreeBlock { conditionCache.heads[sizeClass] };
+	++conditionCache.sizes[sizeClass];
+}
+
 bool Condition::setParam(ConditionParam_t param, int32_t value) {
 	switch (param) {
 		case CONDITION_PARAM_TICKS: {
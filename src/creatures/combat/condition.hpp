@@ -24,6 +24,10 @@ public:
 		subId(initSubId), ticks(initTicks), conditionType(initType), id(initId), isBuff(initBuff) { }
 	virtual ~Condition() = default;
 
+	// Conditions come and go on every hit, their memory is kept per size class and thread instead of returned to the heap
+	static void* operator new(size_t size);
+	static void operator delete(void* block, size_t size);
+
 	virtual bool startCondition(Creature* creature);
 	virtual bool executeCondition(Creature* creature, int32_t interval);
 	virtual void endCondition(Creature* creature) = 0;
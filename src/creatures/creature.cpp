@@ -141,7 +141,7 @@ void Creature::onThink(uint32_t interval) {
 	}
 
 	// scripting event - onThink
-	const CreatureEventList &thinkEvents = getCreatureEvents(CREATURE_EVENT_THINK);
+	const auto &thinkEvents = getCreatureEvents(CREATURE_EVENT_THINK);
 	for (const auto &thinkEvent : thinkEvents) {
 		thinkEvent->executeOnThink(this, interval);
 	}
@@ -274,11 +274,18 @@ void Creature::updateMapCache() {
 	Tile* newTile;
 	const Position &myPos = getPosition();
 	Position pos(0, 0, myPos.z);
+	TileBlockingReader blockingReader(g_game().map, myPos.z);
 
 	for (int32_t y = -maxWalkCacheHeight; y <= maxWalkCacheHeight; ++y) {
 		for (int32_t x = -maxWalkCacheWidth; x <= maxWalkCacheWidth; ++x) {
 			pos.x = myPos.getX() + x;
 			pos.y = myPos.getY() + y;
+			// No creature paths into these, so their tiles are neither created nor queried
+			if (pos != myPos && blockingReader.has(pos.x, pos.y, TILE_BLOCKING_PATH)) {
+				updateTileCache(nullptr, x, y);
+				continue;
+			}
+
 			newTile = g_game().map.getTile(pos);
 			updateTileCache(newTile, pos);
 		}
@@ -694,7 +701,7 @@ bool Creature::dropCorpse(Creature* lastHitCreature, Creature* mostDamageCreatur
 	if (!lootDrop && getMonster()) {
 		if (master) {
 			// Scripting event onDeath
-			const CreatureEventList &deathEvents = getCreatureEvents(CREATURE_EVENT_DEATH);
+			const auto &deathEvents = getCreatureEvents(CREATURE_EVENT_DEATH);
 			for (const auto &deathEvent : deathEvents) {
 				deathEvent->executeOnDeath(this, nullptr, lastHitCreature, mostDamageCreature, lastHitUnjustified, mostDamageUnjustified);
 			}
@@ -988,7 +995,7 @@ void Creature::goToFollowCreature() {
 			}
 		} else {
 			listWalkDir.clear();
-			if (getPathTo(followCreature->getPosition(), listWalkDir, fpp)) {
+			if (g_game().map.getPathFromFlowField(*this, *followCreature, listWalkDir, fpp) || getPathTo(followCreature->getPosition(), listWalkDir, fpp)) {
 				hasFollowPath = true;
 				startAutoWalk(listWalkDir);
 			} else {
@@ -1161,7 +1168,7 @@ bool Creature::onKilledCreature(Creature* target, bool lastHit) {
 	}
 
 	// scripting event - onKill
-	const CreatureEventList &killEvents = getCreatureEvents(CREATURE_EVENT_KILL);
+	const auto &killEvents = getCreatureEvents(CREATURE_EVENT_KILL);
 	for (const auto &killEvent : killEvents) {
 		killEvent->executeOnKill(this, target, lastHit);
 	}
@@ -1244,7 +1251,7 @@ bool Creature::addCondition(Condition* condition) {
 	}
 
 	if (condition->startCondition(this)) {
-		conditions.push_back(condition);
+		insertCondition(condition);
 		onAddCondition(condition->getType());
 		return true;
 	}
@@ -1265,16 +1272,37 @@ bool Creature::addCombatCondition(Condition* condition) {
 	return true;
 }
 
+void Creature::insertCondition(Condition* condition) {
+	conditions.push_back(condition);
+	++conditionTypeCounts[condition->getType()];
+}
+
+void Creature::eraseCondition(size_t index) {
+	--conditionTypeCounts[conditions[index]->getType()];
+	conditions.erase(conditions.begin() + index);
+
+	if (conditionWalkIndex == NOT_WALKING_CONDITIONS || index > conditionWalkIndex) {
+		return;
+	}
+
+	// The one after it moved into its place
+	if (index == conditionWalkIndex) {
+		conditionWalkRemoved = true;
+	} else {
+		--conditionWalkIndex;
+	}
+}
+
 void Creature::removeCondition(ConditionType_t type) {
-	auto it = conditions.begin(), end = conditions.end();
-	while (it != end) {
-		Condition* condition = *it;
+	size_t i = 0;
+	while (hasConditionType(type) && i < conditions.size()) {
+		Condition* condition = conditions[i];
 		if (condition->getType() != type) {
-			++it;
+			++i;
 			continue;
 		}
 
-		it = conditions.erase(it);
+		eraseCondition(i);
 
 		condition->endCondition(this);
 		delete condition;
@@ -1284,11 +1312,11 @@ void Creature::removeCondition(ConditionType_t type) {
 }
 
 void Creature::removeCondition(ConditionType_t conditionType, ConditionId_t conditionId, bool force /* = false*/) {
-	auto it = conditions.begin(), end = conditions.end();
-	while (it != end) {
-		Condition* condition = *it;
+	size_t i = 0;
+	while (hasConditionType(conditionType) && i < conditions.size()) {
+		Condition* condition = conditions[i];
 		if (condition->getType() != conditionType || condition->getId() != conditionId) {
-			++it;
+			++i;
 			continue;
 		}
 
@@ -1300,7 +1328,7 @@ void Creature::removeCondition(ConditionType_t conditionType, ConditionId_t cond
 			}
 		}
 
-		it = conditions.erase(it);
+		eraseCondition(i);
 
 		condition->endCondition(this);
 		delete condition;
@@ -1310,6 +1338,10 @@ void Creature::removeCondition(ConditionType_t conditionType, ConditionId_t cond
 }
 
 void Creature::removeCombatCondition(ConditionType_t type) {
+	if (!hasConditionType(type)) {
+		return;
+	}
+
 	std::vector<Condition*> removeConditions;
 	for (Condition* condition : conditions) {
 		if (condition->getType() == type) {
@@ -1328,7 +1360,7 @@ void Creature::removeCondition(Condition* condition) {
 		return;
 	}
 
-	conditions.erase(it);
+	eraseCondition(static_cast<size_t>(it - conditions.begin()));
 
 	condition->endCondition(this);
 	onEndCondition(condition->getType());
@@ -1336,6 +1368,10 @@ void Creature::removeCondition(Condition* condition) {
 }
 
 Condition* Creature::getCondition(ConditionType_t type) const {
+	if (!hasConditionType(type)) {
+		return nullptr;
+	}
+
 	for (Condition* condition : conditions) {
 		if (condition->getType() == type) {
 			return condition;
@@ -1345,6 +1381,10 @@ Condition* Creature::getCondition(ConditionType_t type) const {
 }
 
 Condition* Creature::getCondition(ConditionType_t type, ConditionId_t conditionId, uint32_t subId /* = 0*/) const {
+	if (!hasConditionType(type)) {
+		return nullptr;
+	}
+
 	for (Condition* condition : conditions) {
 		if (condition->getType() == type && condition->getId() == conditionId && condition->getSubId() == subId) {
 			return condition;
@@ -1355,6 +1395,11 @@ Condition* Creature::getCondition(ConditionType_t type, ConditionId_t conditionI
 
 std::vector<Condition*> Creature::getConditionsByType(ConditionType_t type) const {
 	std::vector<Condition*> conditionsVec;
+	if (!hasConditionType(type)) {
+		return conditionsVec;
+	}
+
+	conditionsVec.reserve(conditionTypeCounts[type]);
 	for (Condition* condition : conditions) {
 		if (condition->getType() == type) {
 			conditionsVec.push_back(condition);
@@ -1364,30 +1409,41 @@ std::vector<Condition*> Creature::getConditionsByType(ConditionType_t type) cons
 }
 
 void Creature::executeConditions(uint32_t interval) {
-	auto it = conditions.begin(), end = conditions.end();
-	while (it != end) {
-		Condition* condition = *it;
-		if (!condition->executeCondition(this, interval)) {
-			ConditionType_t type = condition->getType();
+	// By index, conditions added while executing (e.g. in fight) are appended and executed too.
+	// Executing or ending a condition may remove others, eraseCondition keeps the index on the right one
+	conditionWalkIndex = 0;
+	while (conditionWalkIndex < conditions.size()) {
+		Condition* condition = conditions[conditionWalkIndex];
+		conditionWalkRemoved = false;
+		const bool keep = condition->executeCondition(this, interval);
+		if (conditionWalkRemoved) {
+			// Already removed and ended while executing, the index holds the next one
+			continue;
+		}
 
-			it = conditions.erase(it);
+		if (keep) {
+			++conditionWalkIndex;
+			continue;
+		}
 
-			condition->endCondition(this);
-			delete condition;
+		ConditionType_t type = condition->getType();
 
-			onEndCondition(type);
-		} else {
-			++it;
-		}
+		eraseCondition(conditionWalkIndex);
+
+		condition->endCondition(this);
+		delete condition;
+
+		onEndCondition(type);
 	}
+	conditionWalkIndex = NOT_WALKING_CONDITIONS;
 }
 
 bool Creature::hasCondition(ConditionType_t type, uint32_t subId /* = 0*/) const {
-	if (isSuppress(type)) {
+	if (!hasConditionType(type) || isSuppress(type)) {
 		return false;
 	}
 
-	int64_t timeNow = OTSYS_TIME();
+	int64_t timeNow = g_dispatcher().getCycleTime();
 	for (Condition* condition : conditions) {
 		if (condition->getType() != type || condition->getSubId() != subId) {
 			continue;
@@ -1484,17 +1540,19 @@ bool Creature::registerCreatureEvent(const std::string &name) {
 	}
 
 	CreatureEventType_t type = event->getEventType();
+	CreatureEventList newEvents;
 	if (hasEventRegistered(type)) {
-		for (const auto &creatureEvent : eventsList) {
-			if (creatureEvent == event) {
-				return false;
-			}
+		const auto &events = *eventsByType[type];
+		if (std::ranges::find(events, event) != events.end()) {
+			return false;
 		}
+		newEvents = events;
 	} else {
 		scriptEventsBitField |= static_cast<uint32_t>(1) << type;
 	}
 
-	eventsList.push_back(event);
+	newEvents.push_back(event);
+	eventsByType[type] = std::make_shared<const CreatureEventList>(std::move(newEvents));
 	return true;
 }
 
@@ -1509,44 +1567,22 @@ bool Creature::unregisterCreatureEvent(const std::string &name) {
 		return false;
 	}
 
-	bool resetTypeBit = true;
-
-	auto it = eventsList.begin(), end = eventsList.end();
-	while (it != end) {
-		const auto &curEvent = *it;
-		if (curEvent == event) {
-			it = eventsList.erase(it);
-			continue;
-		}
-
-		if (curEvent->getEventType() == type) {
-			resetTypeBit = false;
-		}
-		++it;
+	const auto &events = *eventsByType[type];
+	if (std::ranges::find(events, event) == events.end()) {
+		return true;
 	}
 
-	if (resetTypeBit) {
+	auto newEvents = std::make_shared<CreatureEventList>(events);
+	std::erase(*newEvents, event);
+	if (newEvents->empty()) {
 		scriptEventsBitField &= ~(static_cast<uint32_t>(1) << type);
+		eventsByType[type] = nullptr;
+	} else {
+		eventsByType[type] = std::move(newEvents);
 	}
 	return true;
 }
 
-CreatureEventList Creature::getCreatureEvents(CreatureEventType_t type) {
-	CreatureEventList tmpEventList;
-
-	if (!hasEventRegistered(type)) {
-		return tmpEventList;
-	}
-
-	for (const auto &creatureEvent : eventsList) {
-		if (creatureEvent->getEventType() == type) {
-			tmpEventList.push_back(creatureEvent);
-		}
-	}
-
-	return tmpEventList;
-}
-
 bool FrozenPathingConditionCall::isInRange(const Position &startPos, const Position &testPos, const FindPathParams &fpp) const {
 	if (fpp.fullPathSearch) {
 		if (testPos.x > targetPos.x + fpp.maxTargetDist) {
@@ -1623,10 +1659,7 @@ bool FrozenPathingConditionCall::operator()(const Position &startPos, const Posi
 }
 
 bool Creature::isInvisible() const {
-	return std::find_if(conditions.begin(), conditions.end(), [](const Condition* condition) {
-			   return condition->getType() == CONDITION_INVISIBLE;
-		   })
-		!= conditions.end();
+	return hasConditionType(CONDITION_INVISIBLE);
 }
 
 bool Creature::getPathTo(const Position &targetPos, std::forward_list<Direction> &dirList, const FindPathParams &fpp) const {
@@ -1774,6 +1807,6 @@ void Creature::setIncreasePercent(CombatType_t combat, int32_t value) {
 	}
 }
 
-const phmap::parallel_flat_hash_set<std::shared_ptr<Zone>> Creature::getZones() {
+ZoneList Creature::getZones() {
 	return Zone::getZones(getPosition());
 }
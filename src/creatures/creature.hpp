@@ -17,8 +17,42 @@
 #include "game/movement/position.hpp"
 #include "items/tile.hpp"
 
-using ConditionList = std::list<Condition*>;
-using CreatureEventList = std::list<std::shared_ptr<CreatureEvent>>;
+using ConditionList = std::vector<Condition*>;
+using CreatureEventList = std::vector<std::shared_ptr<CreatureEvent>>;
+
+/**
+ * The events of one type a creature has registered. Registering or
+ * unregistering an event replaces the creature's list instead of changing
+ * it, so a view being iterated stays valid even if an event unregisters
+ * itself while it runs.
+ */
+class CreatureEventsView {
+public:
+	CreatureEventsView() = default;
+	explicit CreatureEventsView(std::shared_ptr<const CreatureEventList> events) :
+		events(std::move(events)) { }
+
+	CreatureEventList::const_iterator begin() const {
+		return get().begin();
+	}
+	CreatureEventList::const_iterator end() const {
+		return get().end();
+	}
+	size_t size() const {
+		return get().size();
+	}
+	bool empty() const {
+		return get().empty();
+	}
+
+private:
+	const CreatureEventList &get() const {
+		static const CreatureEventList emptyList;
+		return events ? *events : emptyList;
+	}
+
+	std::shared_ptr<const CreatureEventList> events;
+};
 
 class Map;
 class Thing;
@@ -28,7 +62,6 @@ class Monster;
 class Npc;
 class Item;
 class Tile;
-class Zone;
 
 static constexpr int32_t EVENT_CREATURECOUNT = 10;
 static constexpr int32_t EVENT_CREATURE_THINK_INTERVAL = 1000;
@@ -244,7 +277,7 @@ public:
 		return ZONE_NORMAL;
 	}
 
-	const phmap::parallel_flat_hash_set<std::shared_ptr<Zone>> getZones();
+	ZoneList getZones();
 
 	// walk functions
 	void startAutoWalk(const std::forward_list<Direction> &listDir, bool ignoreConditions = false);
@@ -645,8 +678,15 @@ protected:
 	CountMap damageMap;
 
 	std::list<Creature*> summons;
-	CreatureEventList eventsList;
+	// Indexed by CreatureEventType_t, nullptr while none of the type is registered, see CreatureEventsView
+	std::array<std::shared_ptr<const CreatureEventList>, CREATURE_EVENT_EXTENDED_OPCODE + 1> eventsByType;
 	ConditionList conditions;
+	// Indexed by ConditionType_t, how many of the conditions have that type
+	std::array<uint16_t, CONDITION_COUNT> conditionTypeCounts = { 0 };
+	// Condition executeConditions is at, kept in place by eraseCondition
+	static constexpr size_t NOT_WALKING_CONDITIONS = std::numeric_limits<size_t>::max();
+	size_t conditionWalkIndex = NOT_WALKING_CONDITIONS;
+	bool conditionWalkRemoved = false;
 
 	std::forward_list<Direction> listWalkDir;
 
@@ -724,7 +764,20 @@ protected:
 	bool hasEventRegistered(CreatureEventType_t event) const {
 		return (0 != (scriptEventsBitField & (static_cast<uint32_t>(1) << event)));
 	}
-	CreatureEventList getCreatureEvents(CreatureEventType_t type);
+	CreatureEventsView getCreatureEvents(CreatureEventType_t type) const {
+		// Lua passes any number as type
+		if (static_cast<size_t>(type) >= eventsByType.size() || !hasEventRegistered(type)) {
+			return CreatureEventsView();
+		}
+		return CreatureEventsView(eventsByType[type]);
+	}
+
+	// Conditions are only added to or removed from the list through these, they keep conditionTypeCounts up to date
+	bool hasConditionType(ConditionType_t type) const {
+		return type < CONDITION_COUNT && conditionTypeCounts[type] != 0;
+	}
+	void insertCondition(Condition* condition);
+	void eraseCondition(size_t index);
 
 	void updateMapCache();
 	void updateTileCache(const Tile* tile, int32_t dx, int32_t dy);
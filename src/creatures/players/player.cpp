@@ -19,7 +19,7 @@
 #include "game/game.hpp"
 #include "game/scheduling/dispatcher.hpp"
 #include "game/scheduling/scheduler.hpp"
-#include "game/scheduling/task.hpp"
+#include "lib/thread/task.hpp"
 #include "grouping/familiars.hpp"
 #include "lua/creature/creatureevent.hpp"
 #include "lua/creature/events.hpp"
@@ -105,8 +105,9 @@ bool Player::isPushable() const {
 	return Creature::isPushable();
 }
 
-std::shared_ptr<Task> Player::createPlayerTask(uint32_t delay, std::function<void(void)> f) {
-	return std::make_shared<Task>(std::move(f), delay);
+Task Player::createPlayerTask(uint32_t delay, Task &&task) {
+	task.setDelay(delay);
+	return std::move(task);
 }
 
 uint32_t Player::playerFirstID = 0x10000000;
@@ -585,10 +586,15 @@ void Player::updateInventoryImbuement() {
 	// Check if the player is in fight mode
 	bool isInFightMode = hasCondition(CONDITION_INFIGHT);
 
-	// Iterate through all items in the player's inventory
-	for (auto item : getAllInventoryItems()) {
-		// Iterate through all imbuement slots on the item
+	// Only equipped items can tick: aggressive imbuements stop inside containers and the
+	// others only count while worn, so the inventory slots are the registry of ticking items
+	for (int32_t inventorySlot = CONST_SLOT_FIRST; inventorySlot <= CONST_SLOT_LAST; ++inventorySlot) {
+		Item* item = inventory[inventorySlot];
+		if (!item || item->getImbuementSlot() == 0) {
+			continue;
+		}
 
+		// Iterate through all imbuement slots on the item
 		for (uint8_t slotid = 0; slotid < item->getImbuementSlot(); slotid++) {
 			ImbuementInfo imbuementInfo;
 			// Get the imbuement information for the current slot
@@ -1987,28 +1993,28 @@ void Player::checkTradeState(const Item* item) {
 	}
 }
 
-void Player::setNextWalkActionTask(std::shared_ptr<Task> task) {
+void Player::setNextWalkActionTask(Task task) {
 	if (walkTaskEvent != 0) {
 		g_scheduler().stopEvent(walkTaskEvent);
 		walkTaskEvent = 0;
 	}
 
-	walkTask = task;
+	walkTask = std::move(task);
 }
 
-void Player::setNextWalkTask(std::shared_ptr<Task> task) {
+void Player::setNextWalkTask(Task task) {
 	if (nextStepEvent != 0) {
 		g_scheduler().stopEvent(nextStepEvent);
 		nextStepEvent = 0;
 	}
 
 	if (task) {
-		nextStepEvent = g_scheduler().addEvent(task);
+		nextStepEvent = g_scheduler().addEvent(std::move(task));
 		resetIdleTime();
 	}
 }
 
-void Player::setNextActionTask(std::shared_ptr<Task> task, bool resetIdleTime /*= true */) {
+void Player::setNextActionTask(Task task, bool resetIdleTime /*= true */) {
 	if (actionTaskEvent != 0) {
 		g_scheduler().stopEvent(actionTaskEvent);
 		actionTaskEvent = 0;
@@ -2019,25 +2025,25 @@ void Player::setNextActionTask(std::shared_ptr<Task> task, bool resetIdleTime /*
 	}
 
 	if (task) {
-		actionTaskEvent = g_scheduler().addEvent(task);
+		actionTaskEvent = g_scheduler().addEvent(std::move(task));
 		if (resetIdleTime) {
 			this->resetIdleTime();
 		}
 	}
 }
 
-void Player::setNextActionPushTask(std::shared_ptr<Task> task) {
+void Player::setNextActionPushTask(Task task) {
 	if (actionTaskEventPush != 0) {
 		g_scheduler().stopEvent(actionTaskEventPush);
 		actionTaskEventPush = 0;
 	}
 
 	if (task) {
-		actionTaskEventPush = g_scheduler().addEvent(task);
+		actionTaskEventPush = g_scheduler().addEvent(std::move(task));
 	}
 }
 
-void Player::setNextPotionActionTask(std::shared_ptr<Task> task) {
+void Player::setNextPotionActionTask(Task task) {
 	if (actionPotionTaskEvent != 0) {
 		g_scheduler().stopEvent(actionPotionTaskEvent);
 		actionPotionTaskEvent = 0;
@@ -2046,7 +2052,7 @@ void Player::setNextPotionActionTask(std::shared_ptr<Task> task) {
 	cancelPush();
 
 	if (task) {
-		actionPotionTaskEvent = g_scheduler().addEvent(task);
+		actionPotionTaskEvent = g_scheduler().addEvent(std::move(task));
 		// resetIdleTime();
 	}
 }
@@ -2743,34 +2749,34 @@ void Player::death(Creature* lastHitCreature) {
 			mana = manaMax;
 		}
 
-		auto it = conditions.begin(), end = conditions.end();
-		while (it != end) {
-			Condition* condition = *it;
+		size_t i = 0;
+		while (i < conditions.size()) {
+			Condition* condition = conditions[i];
 			// isSupress block to delete spells conditions (ensures that the player cannot, for example, reset the cooldown time of the familiar and summon several)
 			if (condition->isPersistent() && condition->isRemovableOnDeath()) {
-				it = conditions.erase(it);
+				eraseCondition(i);
 
 				condition->endCondition(this);
 				onEndCondition(condition->getType());
 				delete condition;
 			} else {
-				++it;
+				++i;
 			}
 		}
 	} else {
 		setSkillLoss(true);
 
-		auto it = conditions.begin(), end = conditions.end();
-		while (it != end) {
-			Condition* condition = *it;
+		size_t i = 0;
+		while (i < conditions.size()) {
+			Condition* condition = conditions[i];
 			if (condition->isPersistent()) {
-				it = conditions.erase(it);
+				eraseCondition(i);
 
 				condition->endCondition(this);
 				onEndCondition(condition->getType());
 				delete condition;
 			} else {
-				++it;
+				++i;
 			}
 		}
 
@@ -3598,7 +3604,32 @@ size_t Player::getLastIndex() const {
 	return CONST_SLOT_LAST + 1;
 }
 
+uint32_t Player::getInventoryItemCount(uint16_t itemId) const {
+	uint32_t count = 0;
+	for (int32_t i = CONST_SLOT_FIRST; i <= CONST_SLOT_LAST; i++) {
+		const Item* item = inventory[i];
+		if (!item) {
+			continue;
+		}
+
+		if (item->getID() == itemId) {
+			count += item->getItemCount();
+		}
+
+		if (const Container* container = item->getContainer()) {
+			count += container->getContentItemCount(itemId);
+		}
+	}
+	return count;
+}
+
 uint32_t Player::getItemTypeCount(uint16_t itemId, int32_t subType /*= -1*/) const {
+	const uint32_t totalCount = getInventoryItemCount(itemId);
+	// Subtypes (fluids, charges) change in place, only the total per item id is indexed
+	if (subType == -1 || totalCount == 0) {
+		return totalCount;
+	}
+
 	uint32_t count = 0;
 	for (int32_t i = CONST_SLOT_FIRST; i <= CONST_SLOT_LAST; i++) {
 		Item* item = inventory[i];
@@ -3727,26 +3758,12 @@ bool Player::removeItemOfType(uint16_t itemId, uint32_t amount, int32_t subType,
 }
 
 bool Player::hasItemCountById(uint16_t itemId, uint32_t itemAmount, bool checkStash) const {
-	uint32_t newCount = 0;
 	// Check items from inventory
-	for (const auto* item : getAllInventoryItems()) {
-		if (!item || item->getID() != itemId) {
-			continue;
-		}
-
-		newCount += item->getItemCount();
-	}
+	uint32_t newCount = getInventoryItemCount(itemId);
 
 	// Check items from stash
-	for (StashItemList stashToSend = getStashItems();
-		 auto [stashItemId, itemCount] : stashToSend) {
-		if (!checkStash) {
-			break;
-		}
-
-		if (stashItemId == itemId) {
-			newCount += itemCount;
-		}
+	if (checkStash && newCount < itemAmount) {
+		newCount += getStashItemCount(itemId);
 	}
 
 	return newCount >= itemAmount;
@@ -3945,8 +3962,18 @@ std::vector<Item*> Player::getEquippedItems() const {
 }
 
 std::map<uint32_t, uint32_t> &Player::getAllItemTypeCount(std::map<uint32_t, uint32_t> &countMap) const {
-	for (const auto item : getAllInventoryItems()) {
-		countMap[static_cast<uint32_t>(item->getID())] += Item::countByType(item, -1);
+	for (int32_t i = CONST_SLOT_FIRST; i <= CONST_SLOT_LAST; i++) {
+		const Item* item = inventory[i];
+		if (!item) {
+			continue;
+		}
+
+		countMap[static_cast<uint32_t>(item->getID())] += item->getItemCount();
+		if (const Container* container = item->getContainer()) {
+			for (const auto &[itemId, count] : container->getContentItemCounts()) {
+				countMap[static_cast<uint32_t>(itemId)] += count;
+			}
+		}
 	}
 	return countMap;
 }
@@ -4251,11 +4278,11 @@ void Player::doAttacking(uint32_t) {
 			result = Weapon::useFist(this, attackedCreature);
 		}
 
-		std::shared_ptr<Task> task = createPlayerTask(std::max<uint32_t>(SCHEDULER_MINTICKS, delay), std::bind(&Game::checkCreatureAttack, &g_game(), getID()));
+		Task task = createPlayerTask(std::max<uint32_t>(SCHEDULER_MINTICKS, delay), std::bind(&Game::checkCreatureAttack, &g_game(), getID()));
 		if (!classicSpeed) {
-			setNextActionTask(task, false);
+			setNextActionTask(std::move(task), false);
 		} else {
-			g_scheduler().addEvent(task);
+			g_scheduler().addEvent(std::move(task));
 		}
 
 		if (result) {
@@ -4316,7 +4343,7 @@ void Player::onWalkComplete() {
 	}
 
 	if (walkTask) {
-		walkTaskEvent = g_scheduler().addEvent(walkTask);
+		walkTaskEvent = g_scheduler().addEvent(std::move(walkTask));
 		walkTask = nullptr;
 	}
 }
@@ -7526,8 +7553,8 @@ bool Player::canAutoWalk(const Position &toPosition, const std::function<void()>
 		if (getPathTo(toPosition, listDir, 0, 1, true, true)) {
 			g_dispatcher().addTask(std::bind(&Game::playerAutoWalk, &g_game(), getID(), listDir));
 
-			std::shared_ptr<Task> task = createPlayerTask(delay, function);
-			setNextWalkActionTask(task);
+			Task task = createPlayerTask(delay, function);
+			setNextWalkActionTask(std::move(task));
 			return true;
 		} else {
 			sendCancelMessage(RETURNVALUE_THEREISNOWAY);
@@ -33,13 +33,13 @@
 #include "vocations/vocation.hpp"
 #include "creatures/npcs/npc.hpp"
 #include "game/bank/bank.hpp"
+#include "lib/thread/task.hpp"
 
 class House;
 class NetworkMessage;
 class Weapon;
 class ProtocolGame;
 class Party;
-class Task;
 class Bed;
 class Guild;
 class Imbuement;
@@ -85,6 +85,70 @@ struct OpenContainer {
 	uint16_t index;
 };
 
+/**
+ * Player tables that are rewritten as a whole when saved.
+ */
+enum class PlayerSaveSection_t : uint8_t {
+	STASH,
+	SPELLS,
+	KILLS,
+	INVENTORY,
+	DEPOT,
+	REWARDS,
+	INBOX,
+	PREY,
+	TASK_HUNTING,
+	FORGE_HISTORY,
+	BOSSTIARY
+};
+
+/**
+ * Identifies the rows a save section wrote, two independent hashes keep
+ * a collision from silently skipping a changed section.
+ */
+struct SaveFingerprint {
+	uint64_t hash = 0;
+	uint64_t check = 0;
+	size_t rows = 0;
+	bool valid = false;
+
+	bool operator==(const SaveFingerprint &) const = default;
+};
+
+/**
+ * What the player's last committed save wrote to the database, so the
+ * next save only touches the sections and storage keys that changed.
+ */
+struct PlayerSaveState {
+	static constexpr size_t SECTION_COUNT = magic_enum::enum_count<PlayerSaveSection_t>();
+
+	std::array<SaveFingerprint, SECTION_COUNT> sections {};
+	std::map<uint32_t, int32_t> storage;
+	bool storageLoaded = false;
+
+	// Written by the save in progress, applied only once its transaction commits
+	std::array<std::optional<SaveFingerprint>, SECTION_COUNT> pendingSections {};
+	std::optional<std::map<uint32_t, int32_t>> pendingStorage;
+
+	void commit() {
+		for (size_t i = 0; i < SECTION_COUNT; ++i) {
+			if (pendingSections[i]) {
+				sections[i] = *pendingSections[i];
+			}
+		}
+		if (pendingStorage) {
+			storage = std::move(*pendingStorage);
+			storageLoaded = true;
+		}
+		discard();
+	}
+
+	void discard() {
+		pendingSections.fill(std::nullopt);
+		pendingStorage.reset();
+	}
+};
+
 using MuteCountMap = std::map<uint32_t, uint32_t>;
 
 static constexpr int32_t PLAYER_MAX_SPEED = 65535;
@@ -107,7 +171,7 @@ public:
 		return this;
 	}
 
-	static std::shared_ptr<Task> createPlayerTask(uint32_t delay, std::function<void(void)> f);
+	static Task createPlayerTask(uint32_t delay, Task &&task);
 
 	void setID() override;
 
@@ -639,6 +703,11 @@ public:
 	void removeMessageBuffer();
 
 	bool removeItemOfType(uint16_t itemId, uint32_t itemAmount, int32_t subType, bool ignoreEquipped = false);
+	/**
+	 * Count of itemId in the inventory slots and everything inside them,
+	 * read from the containers' content counts without walking them.
+	 */
+	uint32_t getInventoryItemCount(uint16_t itemId) const;
 	/**
 	 * @param itemAmount is uint32_t because stash item is uint32_t max
 	 */
@@ -2494,11 +2563,11 @@ private:
 	 */
 	void updateInventoryImbuement();
 
-	void setNextWalkActionTask(std::shared_ptr<Task> task);
-	void setNextWalkTask(std::shared_ptr<Task> task);
-	void setNextActionTask(std::shared_ptr<Task> task, bool resetIdleTime = true);
-	void setNextActionPushTask(std::shared_ptr<Task> task);
-	void setNextPotionActionTask(std::shared_ptr<Task> task);
+	void setNextWalkActionTask(Task task);
+	void setNextWalkTask(Task task);
+	void setNextActionTask(Task task, bool resetIdleTime = true);
+	void setNextActionPushTask(Task task);
+	void setNextPotionActionTask(Task task);
 
 	void death(Creature* lastHitCreature) override;
 	bool spawn();
@@ -2549,6 +2618,8 @@ private:
 	std::map<uint32_t, int32_t> storageMap;
 	std::map<uint16_t, uint64_t> itemPriceMap;
 
+	PlayerSaveState saveState;
+
 	std::map<uint8_t, uint16_t> maxValuePerSkill = {
 		{ SKILL_LIFE_LEECH_CHANCE, 100 },
 		{ SKILL_MANA_LEECH_CHANCE, 100 },
@@ -2633,7 +2704,7 @@ private:
 	Party* party = nullptr;
 	Player* tradePartner = nullptr;
 	ProtocolGame_ptr client;
-	std::shared_ptr<Task> walkTask;
+	Task walkTask;
 	Town* town = nullptr;
 	Vocation* vocation = nullptr;
 	RewardChest* rewardChest = nullptr;
@@ -2746,6 +2817,7 @@ private:
 	bool ghostMode = false;
 	bool pzLocked = false;
 	bool isConnecting = false;
+	bool isLoading = false;
 	bool addAttackSkillPoint = false;
 	bool inventoryAbilities[CONST_SLOT_LAST + 1] = {};
 	bool quickLootFallbackToMainContainer = false;
@@ -2846,6 +2918,7 @@ private:
 	friend class PlayerWheel;
 	friend class IOLoginDataLoad;
 	friend class IOLoginDataSave;
+	friend class SaveManager;
 
 	std::unique_ptr<PlayerWheel> m_wheelPlayer;
 
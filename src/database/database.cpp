@@ -12,37 +12,45 @@
 #include "config/configmanager.hpp"
 #include "database/database.hpp"
 
+// Prefetched results served by storeQuery on this thread, see DBPrefetchScope
+static thread_local DBPrefetchedResults* activePrefetch = nullptr;
+// Batch executeQuery appends to instead of running on this thread, see DBRecordScope
+static thread_local DBStatementBatch* activeRecord = nullptr;
+// Connection the calling thread's open transaction runs on
+static thread_local MYSQL* transactionConnection = nullptr;
+// Transactions begun on this thread while one was already open join it, only the outermost one commits
+static thread_local uint32_t transactionDepth = 0;
+// A joined transaction rolled back, so the outermost one must not commit
+static thread_local bool transactionRollbackOnly = false;
+static thread_local uint64_t lastInsertId = 0;
+
 Database::~Database() {
-	if (handle != nullptr) {
-		mysql_close(handle);
+	for (MYSQL* connection : connections) {
+		mysql_close(connection);
 	}
 }
 
 bool Database::connect() {
-	return connect(&g_configManager().getString(MYSQL_HOST), &g_configManager().getString(MYSQL_USER), &g_configManager().getString(MYSQL_PASS), &g_configManager().getString(MYSQL_DB), g_configManager().getNumber(SQL_PORT), &g_configManager().getString(MYSQL_SOCK));
+	const auto poolSize = static_cast<uint32_t>(std::max<int32_t>(g_configManager().getNumber(SQL_POOL_SIZE), 1));
+	return connect(&g_configManager().getString(MYSQL_HOST), &g_configManager().getString(MYSQL_USER), &g_configManager().getString(MYSQL_PASS), &g_configManager().getString(MYSQL_DB), g_configManager().getNumber(SQL_PORT), &g_configManager().getString(MYSQL_SOCK), poolSize);
 }
 
-bool Database::connect(const std::string* host, const std::string* user, const std::string* password, const std::string* database, uint32_t port, const std::string* sock) {
-	// connection handle initialization
-	handle = mysql_init(nullptr);
-	if (!handle) {
-		g_logger().error("Failed to initialize MySQL connection handle.");
-		return false;
-	}
-
+bool Database::connect(const std::string* host, const std::string* user, const std::string* password, const std::string* database, uint32_t port, const std::string* sock, uint32_t poolSize /* = 1*/) {
 	if (host->empty() || user->empty() || password->empty() || database->empty() || port <= 0) {
 		g_logger().warn("MySQL host, user, password, database or port not provided");
 	}
 
-	// automatic reconnect
-	bool reconnect = true;
-	mysql_options(handle, MYSQL_OPT_RECONNECT, &reconnect);
+	for (uint32_t i = 0; i < poolSize; ++i) {
+		MYSQL* connection = openConnection(host, user, password, database, port, sock);
+		if (!connection) {
+			return false;
+		}
 
-	// connects to database
-	if (!mysql_real_connect(handle, host->c_str(), user->c_str(), password->c_str(), database->c_str(), port, sock->c_str(), 0)) {
-		g_logger().error("MySQL Error Message: {}", mysql_error(handle));
-		return false;
+		connections.push_back(connection);
+		idleConnections.push_back(connection);
 	}
+	handle = connections.front();
+	g_logger().debug("MySQL connection pool opened with {} connections", connections.size());
 
 	DBResult_ptr result = storeQuery("SHOW VARIABLES LIKE 'max_allowed_packet'");
 	if (result) {
@@ -51,50 +59,175 @@ bool Database::connect(const std::string* host, const std::string* user, const s
 	return true;
 }
 
+MYSQL* Database::openConnection(const std::string* host, const std::string* user, const std::string* password, const std::string* database, uint32_t port, const std::string* sock) const {
+	// connection handle initialization
+	MYSQL* connection = mysql_init(nullptr);
+	if (!connection) {
+		g_logger().error("Failed to initialize MySQL connection handle.");
+		return nullptr;
+	}
+
+	// automatic reconnect
+	bool reconnect = true;
+	mysql_options(connection, MYSQL_OPT_RECONNECT, &reconnect);
+
+	// connects to database
+	if (!mysql_real_connect(connection, host->c_str(), user->c_str(), password->c_str(), database->c_str(), port, sock->c_str(), 0)) {
+		g_logger().error("MySQL Error Message: {}", mysql_error(connection));
+		mysql_close(connection);
+		return nullptr;
+	}
+	return connection;
+}
+
+MYSQL* Database::acquireConnection() {
+	std::unique_lock lock { poolLock };
+	checkouts.fetch_add(1, std::memory_order_relaxed);
+	if (idleConnections.empty()) {
+		const auto waitStart = std::chrono::steady_clock::now();
+		poolSignal.wait(lock, [this] { return !idleConnections.empty(); });
+
+		const auto waited = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - waitStart).count());
+		checkoutWaits.fetch_add(1, std::memory_order_relaxed);
+		totalWaitMicroseconds.fetch_add(waited, std::memory_order_relaxed);
+		if (waited > maxWaitMicroseconds.load(std::memory_order_relaxed)) {
+			maxWaitMicroseconds.store(waited, std::memory_order_relaxed);
+		}
+	}
+
+	MYSQL* connection = idleConnections.back();
+	idleConnections.pop_back();
+
+	const uint32_t inUse = connectionsInUse.fetch_add(1, std::memory_order_relaxed) + 1;
+	if (inUse > connectionsInUseHighWaterMark.load(std::memory_order_relaxed)) {
+		connectionsInUseHighWaterMark.store(inUse, std::memory_order_relaxed);
+	}
+	return connection;
+}
+
+void Database::releaseConnection(MYSQL* connection) {
+	{
+		std::scoped_lock lock { poolLock };
+		idleConnections.push_back(connection);
+		connectionsInUse.fetch_sub(1, std::memory_order_relaxed);
+	}
+	poolSignal.notify_one();
+}
+
+void Database::logPoolMetrics() const {
+	const uint64_t waits = getCheckoutWaits();
+	g_logger().info("Database pool: {} connections, {} in use (peak {}), {} checkouts, {} waited (avg {} us, max {} us)", getPoolSize(), getConnectionsInUse(), getConnectionsInUseHighWaterMark(), getCheckouts(), waits, waits == 0 ? 0 : getTotalWaitMicroseconds() / waits, getMaxWaitMicroseconds());
+}
+
+Database::ConnectionLease::ConnectionLease(Database &db) :
+	db(db), connection(transactionConnection), pinned(transactionConnection != nullptr) {
+	if (!pinned) {
+		connection = db.acquireConnection();
+	}
+}
+
+Database::ConnectionLease::~ConnectionLease() {
+	if (!pinned) {
+		db.releaseConnection(connection);
+	}
+}
+
 bool Database::beginTransaction() {
+	if (activeRecord) {
+		// The recorded batch runs as one transaction of its own
+		return true;
+	}
+
+	if (!handle) {
+		g_logger().error("Database not initialized!");
+		return false;
+	}
+
+	if (transactionConnection) {
+		g_logger().debug("[Database::beginTransaction] A transaction is already open on this thread, joining it");
+		++transactionDepth;
+		return true;
+	}
+
+	// Every query of the transaction has to run on the same connection
+	transactionConnection = acquireConnection();
 	if (!executeQuery("BEGIN")) {
+		releaseConnection(std::exchange(transactionConnection, nullptr));
 		return false;
 	}
-	databaseLock.lock();
+	transactionDepth = 1;
+	transactionRollbackOnly = false;
 	return true;
 }
 
 bool Database::rollback() {
-	if (!handle) {
-		g_logger().error("Database not initialized!");
-		return false;
+	if (activeRecord) {
+		return true;
 	}
 
-	if (mysql_rollback(handle) != 0) {
-		g_logger().error("Message: {}", mysql_error(handle));
-		databaseLock.unlock();
+	if (!transactionConnection) {
+		g_logger().error("Database transaction not started!");
 		return false;
 	}
 
-	databaseLock.unlock();
-	return true;
+	if (transactionDepth > 1) {
+		// Only the outermost transaction can undo anything, it rolls back instead of committing
+		--transactionDepth;
+		transactionRollbackOnly = true;
+		return true;
+	}
+
+	transactionDepth = 0;
+	MYSQL* connection = std::exchange(transactionConnection, nullptr);
+	const bool success = mysql_rollback(connection) == 0;
+	if (!success) {
+		g_logger().error("Message: {}", mysql_error(connection));
+	}
+
+	releaseConnection(connection);
+	return success;
 }
 
 bool Database::commit() {
-	if (!handle) {
-		g_logger().error("Database not initialized!");
+	if (activeRecord) {
+		return true;
+	}
+
+	if (!transactionConnection) {
+		g_logger().error("Database transaction not started!");
 		return false;
 	}
-	if (mysql_commit(handle) != 0) {
-		g_logger().error("Message: {}", mysql_error(handle));
-		databaseLock.unlock();
+
+	if (transactionDepth > 1) {
+		--transactionDepth;
+		return true;
+	}
+
+	transactionDepth = 0;
+	MYSQL* connection = std::exchange(transactionConnection, nullptr);
+	if (std::exchange(transactionRollbackOnly, false)) {
+		g_logger().error("[Database::commit] A joined transaction was rolled back, rolling back the whole transaction");
+		if (mysql_rollback(connection) != 0) {
+			g_logger().error("Message: {}", mysql_error(connection));
+		}
+		releaseConnection(connection);
 		return false;
 	}
 
-	databaseLock.unlock();
-	return true;
+	const bool success = mysql_commit(connection) == 0;
+	if (!success) {
+		g_logger().error("Message: {}", mysql_error(connection));
+	}
+
+	releaseConnection(connection);
+	return success;
 }
 
-bool Database::retryQuery(const std::string_view &query, int retries) {
-	while (retries > 0 && mysql_query(handle, query.data()) != 0) {
+bool Database::retryQuery(MYSQL* connection, const std::string_view &query, int retries) const {
+	while (retries > 0 && mysql_query(connection, query.data()) != 0) {
 		g_logger().error("Query: {}", query.substr(0, 256));
-		g_logger().error("MySQL error [{}]: {}", mysql_errno(handle), mysql_error(handle));
-		if (!isRecoverableError(mysql_errno(handle))) {
+		g_logger().error("MySQL error [{}]: {}", mysql_errno(connection), mysql_error(connection));
+		if (!isRecoverableError(mysql_errno(connection))) {
 			return false;
 		}
 		std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -109,32 +242,44 @@ bool Database::retryQuery(const std::string_view &query, int retries) {
 }
 
 bool Database::executeQuery(const std::string_view &query) {
+	if (activeRecord) {
+		activeRecord->add(query);
+		return true;
+	}
+
 	if (!handle) {
 		g_logger().error("Database not initialized!");
 		return false;
 	}
 
-	std::scoped_lock lock { databaseLock };
+	ConnectionLease connection(*this);
 
-	bool success = retryQuery(query, 10);
+	bool success = retryQuery(connection.get(), query, 10);
+	if (success) {
+		lastInsertId = static_cast<uint64_t>(mysql_insert_id(connection.get()));
+	}
 
-	mysql_free_result(mysql_store_result(handle));
+	mysql_free_result(mysql_store_result(connection.get()));
 	return success;
 }
 
 DBResult_ptr Database::storeQuery(const std::string_view &query) {
+	if (DBResult_ptr prefetched; activePrefetch && activePrefetch->take(query, prefetched)) {
+		return prefetched;
+	}
+
 	if (!handle) {
 		g_logger().error("Database not initialized!");
 		return nullptr;
 	}
 
-	std::scoped_lock lock { databaseLock };
+	ConnectionLease connection(*this);
 
 retry:
-	if (mysql_query(handle, query.data()) != 0) {
+	if (mysql_query(connection.get(), query.data()) != 0) {
 		g_logger().error("Query: {}", query);
-		g_logger().error("Message: {}", mysql_error(handle));
-		if (!isRecoverableError(mysql_errno(handle))) {
+		g_logger().error("Message: {}", mysql_error(connection.get()));
+		if (!isRecoverableError(mysql_errno(connection.get()))) {
 			return nullptr;
 		}
 		std::this_thread::sleep_for(std::chrono::seconds(1));
@@ -142,7 +287,7 @@ retry:
 	}
 
 	// Retrieving results of query
-	MYSQL_RES* res = mysql_store_result(handle);
+	MYSQL_RES* res = mysql_store_result(connection.get());
 	if (res != nullptr) {
 		DBResult_ptr result = std::make_shared<DBResult>(res);
 		if (!result->hasNext()) {
@@ -153,6 +298,10 @@ retry:
 	return nullptr;
 }
 
+uint64_t Database::getLastInsertId() const {
+	return lastInsertId;
+}
+
 std::string Database::escapeString(const std::string &s) const {
 	std::string::size_type len = s.length();
 	auto length = static_cast<uint32_t>(len);
@@ -181,6 +330,60 @@ std::string Database::escapeBlob(const char* s, uint32_t length) const {
 	return escaped;
 }
 
+void DBPrefetchedResults::store(const std::string &query, DBResult_ptr result) {
+	results.insert_or_assign(query, std::move(result));
+}
+
+bool DBPrefetchedResults::take(const std::string_view &query, DBResult_ptr &result) {
+	auto it = results.find(query);
+	if (it == results.end()) {
+		return false;
+	}
+
+	result = std::move(it->second);
+	results.erase(it);
+	return true;
+}
+
+DBPrefetchScope::DBPrefetchScope(DBPrefetchedResults &results) :
+	results(results), previous(activePrefetch) {
+	activePrefetch = &results;
+}
+
+DBPrefetchScope::~DBPrefetchScope() {
+	activePrefetch = previous;
+	if (results.size() > 0) {
+		// A loader returned before running its query, or a prefetched query is no longer loaded
+		g_logger().debug("[DBPrefetchScope] {} prefetched results were never used", results.size());
+	}
+}
+
+void DBStatementBatch::add(const std::string_view &statement) {
+	statements.emplace_back(statement);
+	bytes += statement.size();
+}
+
+bool DBStatementBatch::execute() const {
+	return DBTransaction::executeWithinTransaction([this]() {
+		Database &db = Database::getInstance();
+		for (const auto &statement : statements) {
+			if (!db.executeQuery(statement)) {
+				throw DatabaseException("Failed to execute recorded statement: " + statement.substr(0, 256));
+			}
+		}
+		return true;
+	});
+}
+
+DBRecordScope::DBRecordScope(DBStatementBatch &batch) :
+	previous(activeRecord) {
+	activeRecord = &batch;
+}
+
+DBRecordScope::~DBRecordScope() {
+	activeRecord = previous;
+}
+
 DBResult::DBResult(MYSQL_RES* res) {
 	handle = res;
 
@@ -29,9 +29,8 @@ public:
 
 	bool connect();
 
-	bool connect(const std::string* host, const std::string* user, const std::string* password, const std::string* database, uint32_t port, const std::string* sock);
+	bool connect(const std::string* host, const std::string* user, const std::string* password, const std::string* database, uint32_t port, const std::string* sock, uint32_t poolSize = 1);
 
-	bool retryQuery(const std::string_view &query, int retries);
 	bool executeQuery(const std::string_view &query);
 
 	DBResult_ptr storeQuery(const std::string_view &query);
@@ -40,9 +39,10 @@ public:
 
 	std::string escapeBlob(const char* s, uint32_t length) const;
 
-	uint64_t getLastInsertId() const {
-		return static_cast<uint64_t>(mysql_insert_id(handle));
-	}
+	/**
+	 * \returns The id generated by the last insert executed on the calling thread.
+	 */
+	uint64_t getLastInsertId() const;
 
 	static const char* getClientVersion() {
 		return mysql_get_client_info();
@@ -52,7 +52,64 @@ public:
 		return maxPacketSize;
 	}
 
+	size_t getPoolSize() const {
+		return connections.size();
+	}
+	uint32_t getConnectionsInUse() const {
+		return connectionsInUse.load(std::memory_order_relaxed);
+	}
+	uint32_t getConnectionsInUseHighWaterMark() const {
+		return connectionsInUseHighWaterMark.load(std::memory_order_relaxed);
+	}
+	uint64_t getCheckouts() const {
+		return checkouts.load(std::memory_order_relaxed);
+	}
+	uint64_t getCheckoutWaits() const {
+		return checkoutWaits.load(std::memory_order_relaxed);
+	}
+	uint64_t getTotalWaitMicroseconds() const {
+		return totalWaitMicroseconds.load(std::memory_order_relaxed);
+	}
+	uint64_t getMaxWaitMicroseconds() const {
+		return maxWaitMicroseconds.load(std::memory_order_relaxed);
+	}
+	/**
+	 * Logs the connection pool usage since startup, to tell whether
+	 * the pool is too small for the saves and queries it serves.
+	 */
+	void logPoolMetrics() const;
+
 private:
+	/**
+	 * Connection used by one query. Inside a transaction it is the
+	 * connection pinned to the calling thread, otherwise a free one
+	 * is checked out of the pool for the lifetime of the lease.
+	 */
+	class ConnectionLease {
+	public:
+		explicit ConnectionLease(Database &db);
+		~ConnectionLease();
+
+		// non-copyable
+		ConnectionLease(const ConnectionLease &) = delete;
+		ConnectionLease &operator=(const ConnectionLease &) = delete;
+
+		MYSQL* get() const {
+			return connection;
+		}
+
+	private:
+		Database &db;
+		MYSQL* connection;
+		bool pinned;
+	};
+
+	MYSQL* openConnection(const std::string* host, const std::string* user, const std::string* password, const std::string* database, uint32_t port, const std::string* sock) const;
+	MYSQL* acquireConnection();
+	void releaseConnection(MYSQL* connection);
+
+	bool retryQuery(MYSQL* connection, const std::string_view &query, int retries) const;
+
 	bool beginTransaction();
 	bool rollback();
 	bool commit();
@@ -62,13 +119,92 @@ private:
 	}
 
 private:
+	// First connection of the pool, also used for escaping since that only depends on the character set
 	MYSQL* handle = nullptr;
-	std::recursive_mutex databaseLock;
+	std::vector<MYSQL*> connections;
+	std::vector<MYSQL*> idleConnections;
+	std::mutex poolLock;
+	std::condition_variable poolSignal;
 	uint64_t maxPacketSize = 1048576;
 
+	std::atomic<uint32_t> connectionsInUse = 0;
+	std::atomic<uint32_t> connectionsInUseHighWaterMark = 0;
+	std::atomic<uint64_t> checkouts = 0;
+	std::atomic<uint64_t> checkoutWaits = 0;
+	std::atomic<uint64_t> totalWaitMicroseconds = 0;
+	std::atomic<uint64_t> maxWaitMicroseconds = 0;
+
 	friend class DBTransaction;
 };
 
+/**
+ * Results of queries run ahead of time, typically on the thread pool.
+ * While a DBPrefetchScope is active on a thread, Database::storeQuery
+ * answers any query with the exact same text from here, once.
+ */
+class DBPrefetchedResults {
+public:
+	void store(const std::string &query, DBResult_ptr result);
+	bool take(const std::string_view &query, DBResult_ptr &result);
+
+	size_t size() const {
+		return results.size();
+	}
+
+private:
+	phmap::flat_hash_map<std::string, DBResult_ptr> results;
+};
+
+class DBPrefetchScope {
+public:
+	explicit DBPrefetchScope(DBPrefetchedResults &results);
+	~DBPrefetchScope();
+
+	// non-copyable
+	DBPrefetchScope(const DBPrefetchScope &) = delete;
+	DBPrefetchScope &operator=(const DBPrefetchScope &) = delete;
+
+private:
+	DBPrefetchedResults &results;
+	DBPrefetchedResults* previous;
+};
+
+/**
+ * Statements captured instead of executed. While a DBRecordScope is active
+ * on a thread, Database::executeQuery appends here and reports success, and
+ * transactions are left to execute(), which runs the whole batch as one
+ * transaction, on whichever thread calls it.
+ */
+class DBStatementBatch {
+public:
+	void add(const std::string_view &statement);
+	bool execute() const;
+
+	size_t size() const {
+		return statements.size();
+	}
+	size_t getBytes() const {
+		return bytes;
+	}
+
+private:
+	std::vector<std::string> statements;
+	size_t bytes = 0;
+};
+
+class DBRecordScope {
+public:
+	explicit DBRecordScope(DBStatementBatch &batch);
+	~DBRecordScope();
+
+	// non-copyable
+	DBRecordScope(const DBRecordScope &) = delete;
+	DBRecordScope &operator=(const DBRecordScope &) = delete;
+
+private:
+	DBStatementBatch* previous;
+};
+
 class DBResult {
 public:
 	explicit DBResult(MYSQL_RES* res);
@@ -198,8 +334,8 @@ public:
 		try {
 			transaction.begin();
 			bool result = toBeExecuted();
-			transaction.commit();
-			return result;
+			// A failed commit leaves nothing of the transaction in the database
+			return transaction.commit() && result;
 		} catch (const std::exception &exception) {
 			transaction.rollback();
 			g_logger().error("[{}] Error occurred committing transaction, error: {}", __FUNCTION__, exception.what());
@@ -242,21 +378,22 @@ private:
 		}
 	}
 
-	void commit() {
+	bool commit() {
 		// Ensure that the transaction has been started
 		if (state != STATE_START) {
 			g_logger().error("Transaction not started");
-			return;
+			return false;
 		}
 
 		try {
 			// Commit the transaction
 			state = STATE_COMMIT;
-			Database::getInstance().commit();
+			return Database::getInstance().commit();
 		} catch (const std::exception &exception) {
 			// An error occurred while committing the transaction
 			state = STATE_NO_START;
 			g_logger().error("[{}] An error occurred while committing the transaction, error: {}", __FUNCTION__, exception.what());
+			return false;
 		}
 	}
 
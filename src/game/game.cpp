@@ -24,12 +24,14 @@
 #include "io/iologindata.hpp"
 #include "io/io_wheel.hpp"
 #include "io/iomarket.hpp"
+#include "io/iohighscores.hpp"
 #include "items/items.hpp"
 #include "lua/scripts/lua_environment.hpp"
 #include "creatures/monsters/monster.hpp"
 #include "lua/creature/movement.hpp"
 #include "game/scheduling/dispatcher.hpp"
 #include "game/scheduling/scheduler.hpp"
+#include "game/scheduling/save_manager.hpp"
 #include "server/server.hpp"
 #include "creatures/combat/spells.hpp"
 #include "lua/creature/talkaction.hpp"
@@ -45,6 +47,7 @@
 #include "protobuf/appearances.pb.hpp"
 #include "server/network/protocol/protocollogin.hpp"
 #include "server/network/protocol/protocolstatus.hpp"
+#include "server/network/message/outputmessage.hpp"
 
 namespace InternalGame {
 	void sendBlockEffect(BlockType_t blockType, CombatType_t combatType, const Position &targetPos, Creature* source) {
@@ -386,6 +389,14 @@ void Game::setGameState(GameState_t newState) {
 }
 
 void Game::saveGameState() {
+	if (g_configManager().getBoolean(TOGGLE_SAVE_ASYNC) && gameState == GAME_STATE_NORMAL) {
+		saveGameStateAsync();
+		return;
+	}
+
+	// Anything a background save has not written yet must land before this save
+	g_saveManager().flushAll();
+
 	if (gameState == GAME_STATE_NORMAL) {
 		setGameState(GAME_STATE_MAINTAIN);
 	}
@@ -402,12 +413,35 @@ void Game::saveGameState() {
 	}
 
 	Map::save();
+	Database::getInstance().logPoolMetrics();
 
 	if (gameState == GAME_STATE_MAINTAIN) {
 		setGameState(GAME_STATE_NORMAL);
 	}
 }
 
+void Game::saveGameStateAsync() {
+	SaveManager &saveManager = g_saveManager();
+	if (!saveManager.beginSave()) {
+		return;
+	}
+
+	g_logger().info("Saving server in the background...");
+	for (const auto &it : players) {
+		it.second->loginPosition = it.second->getPosition();
+		saveManager.addPlayer(it.second);
+	}
+
+	saveManager.addWorld([this]() {
+		for (const auto &it : guilds) {
+			IOGuild::saveGuild(it.second);
+		}
+		Map::save();
+	});
+
+	saveManager.startWrites(static_cast<uint32_t>(std::max<int32_t>(g_configManager().getNumber(SAVE_ASYNC_WINDOW), 0)) * 1000);
+}
+
 bool Game::loadItemsPrice() {
 	itemsSaleCount = 0;
 	std::ostringstream query, marketQuery;
@@ -736,21 +770,20 @@ Creature* Game::getCreatureByName(const std::string &s) {
 		return nullptr;
 	}
 
-	const std::string &lowerCaseName = asLowerCaseString(s);
-
-	auto m_it = mappedPlayerNames.find(lowerCaseName);
+	auto m_it = mappedPlayerNames.find(s);
 	if (m_it != mappedPlayerNames.end()) {
 		return m_it->second;
 	}
 
+	const char* creatureName = s.c_str();
 	for (const auto &it : npcs) {
-		if (lowerCaseName == asLowerCaseString(it.second->getName())) {
+		if (strcasecmp(creatureName, it.second->getName().c_str()) == 0) {
 			return it.second;
 		}
 	}
 
 	for (const auto &it : monsters) {
-		if (lowerCaseName == asLowerCaseString(it.second->getName())) {
+		if (strcasecmp(creatureName, it.second->getName().c_str()) == 0) {
 			return it.second;
 		}
 	}
@@ -776,7 +809,7 @@ Player* Game::getPlayerByName(const std::string &s, bool loadTmp /* = false */)
 		return nullptr;
 	}
 
-	auto it = mappedPlayerNames.find(asLowerCaseString(s));
+	auto it = mappedPlayerNames.find(s);
 	if (it == mappedPlayerNames.end()) {
 		if (!loadTmp) {
 			return nullptr;
@@ -796,12 +829,11 @@ Player* Game::getPlayerByGUID(const uint32_t &guid) {
 	if (guid == 0) {
 		return nullptr;
 	}
-	for (const auto &it : players) {
-		if (guid == it.second->getGUID()) {
-			return it.second;
-		}
+	auto it = mappedPlayerGuids.find(guid);
+	if (it == mappedPlayerGuids.end()) {
+		return nullptr;
 	}
-	return nullptr;
+	return it->second;
 }
 
 ReturnValue Game::getPlayerByNameWildcard(const std::string &s, Player*&player) {
@@ -936,6 +968,7 @@ bool Game::removeCreature(Creature* creature, bool isLogout /* = true*/) {
 
 	creature->removeList();
 	creature->setRemoved();
+	map.removeFlowField(creature->getID());
 	ReleaseCreature(creature);
 
 	removeCreatureCheck(creature);
@@ -1085,11 +1118,11 @@ void Game::playerMoveThing(uint32_t playerId, const Position &fromPos, uint16_t
 		}
 
 		if (Position::areInRange<1, 1, 0>(movingCreature->getPosition(), player->getPosition())) {
-			std::shared_ptr<Task> task = createPlayerTask(
+			Task task = createPlayerTask(
 				g_configManager().getNumber(PUSH_DELAY),
 				std::bind(&Game::playerMoveCreatureByID, this, player->getID(), movingCreature->getID(), movingCreature->getPosition(), tile->getPosition())
 			);
-			player->setNextActionPushTask(task);
+			player->setNextActionPushTask(std::move(task));
 		} else {
 			playerMoveCreature(player, movingCreature, movingCreature->getPosition(), tile);
 		}
@@ -1127,9 +1160,9 @@ void Game::playerMoveCreatureByID(uint32_t playerId, uint32_t movingCreatureId,
 void Game::playerMoveCreature(Player* player, Creature* movingCreature, const Position &movingCreatureOrigPos, Tile* toTile) {
 	if (!player->canDoAction()) {
 		uint32_t delay = 600;
-		std::shared_ptr<Task> task = createPlayerTask(delay, std::bind(&Game::playerMoveCreatureByID, this, player->getID(), movingCreature->getID(), movingCreatureOrigPos, toTile->getPosition()));
+		Task task = createPlayerTask(delay, std::bind(&Game::playerMoveCreatureByID, this, player->getID(), movingCreature->getID(), movingCreatureOrigPos, toTile->getPosition()));
 
-		player->setNextActionPushTask(task);
+		player->setNextActionPushTask(std::move(task));
 		return;
 	}
 
@@ -1141,10 +1174,10 @@ void Game::playerMoveCreature(Player* player, Creature* movingCreature, const Po
 		if (player->getPathTo(movingCreatureOrigPos, listDir, 0, 1, true, true)) {
 			g_dispatcher().addTask(std::bind(&Game::playerAutoWalk, this, player->getID(), listDir));
 
-			std::shared_ptr<Task> task = createPlayerTask(600, std::bind(&Game::playerMoveCreatureByID, this, player->getID(), movingCreature->getID(), movingCreatureOrigPos, toTile->getPosition()));
+			Task task = createPlayerTask(600, std::bind(&Game::playerMoveCreatureByID, this, player->getID(), movingCreature->getID(), movingCreatureOrigPos, toTile->getPosition()));
 
 			player->pushEvent(true);
-			player->setNextActionPushTask(task);
+			player->setNextActionPushTask(std::move(task));
 		} else {
 			player->sendCancelMessage(RETURNVALUE_THEREISNOWAY);
 		}
@@ -1347,8 +1380,8 @@ void Game::playerMoveItemByPlayerID(uint32_t playerId, const Position &fromPos,
 void Game::playerMoveItem(Player* player, const Position &fromPos, uint16_t itemId, uint8_t fromStackPos, const Position &toPos, uint8_t count, Item* item, Cylinder* toCylinder) {
 	if (!player->canDoAction()) {
 		uint32_t delay = player->getNextActionTime();
-		std::shared_ptr<Task> task = createPlayerTask(delay, std::bind(&Game::playerMoveItemByPlayerID, this, player->getID(), fromPos, itemId, fromStackPos, toPos, count));
-		player->setNextActionTask(task);
+		Task task = createPlayerTask(delay, std::bind(&Game::playerMoveItemByPlayerID, this, player->getID(), fromPos, itemId, fromStackPos, toPos, count));
+		player->setNextActionTask(std::move(task));
 		return;
 	}
 
@@ -1444,8 +1477,8 @@ void Game::playerMoveItem(Player* player, const Position &fromPos, uint16_t item
 		if (player->getPathTo(item->getPosition(), listDir, 0, 1, true, true)) {
 			g_dispatcher().addTask(std::bind(&Game::playerAutoWalk, this, player->getID(), listDir));
 
-			std::shared_ptr<Task> task = createPlayerTask(400, std::bind(&Game::playerMoveItemByPlayerID, this, player->getID(), fromPos, itemId, fromStackPos, toPos, count));
-			player->setNextWalkActionTask(task);
+			Task task = createPlayerTask(400, std::bind(&Game::playerMoveItemByPlayerID, this, player->getID(), fromPos, itemId, fromStackPos, toPos, count));
+			player->setNextWalkActionTask(std::move(task));
 		} else {
 			player->sendCancelMessage(RETURNVALUE_THEREISNOWAY);
 		}
@@ -1501,8 +1534,8 @@ void Game::playerMoveItem(Player* player, const Position &fromPos, uint16_t item
 			if (player->getPathTo(walkPos, listDir, 0, 0, true, true)) {
 				g_dispatcher().addTask(std::bind(&Game::playerAutoWalk, this, player->getID(), listDir));
 
-				std::shared_ptr<Task> task = createPlayerTask(400, std::bind(&Game::playerMoveItemByPlayerID, this, player->getID(), itemPos, itemId, itemStackPos, toPos, count));
-				player->setNextWalkActionTask(task);
+				Task task = createPlayerTask(400, std::bind(&Game::playerMoveItemByPlayerID, this, player->getID(), itemPos, itemId, itemStackPos, toPos, count));
+				player->setNextWalkActionTask(std::move(task));
 			} else {
 				player->sendCancelMessage(RETURNVALUE_THEREISNOWAY);
 			}
@@ -3206,11 +3239,11 @@ void Game::playerUseItemEx(uint32_t playerId, const Position &fromPos, uint8_t f
 			if (player->getPathTo(walkToPos, listDir, 0, 1, true, true)) {
 				g_dispatcher().addTask(std::bind(&Game::playerAutoWalk, this, player->getID(), listDir));
 
-				std::shared_ptr<Task> task = createPlayerTask(400, std::bind(&Game::playerUseItemEx, this, playerId, itemPos, itemStackPos, fromItemId, toPos, toStackPos, toItemId));
+				Task task = createPlayerTask(400, std::bind(&Game::playerUseItemEx, this, playerId, itemPos, itemStackPos, fromItemId, toPos, toStackPos, toItemId));
 				if (it.isRune() || it.type == ITEM_TYPE_POTION) {
-					player->setNextPotionActionTask(task);
+					player->setNextPotionActionTask(std::move(task));
 				} else {
-					player->setNextWalkActionTask(task);
+					player->setNextWalkActionTask(std::move(task));
 				}
 			} else {
 				player->sendCancelMessage(RETURNVALUE_THEREISNOWAY);
@@ -3232,11 +3265,11 @@ void Game::playerUseItemEx(uint32_t playerId, const Position &fromPos, uint8_t f
 		if (it.isRune() || it.type == ITEM_TYPE_POTION) {
 			delay = player->getNextPotionActionTime();
 		}
-		std::shared_ptr<Task> task = createPlayerTask(delay, std::bind(&Game::playerUseItemEx, this, playerId, fromPos, fromStackPos, fromItemId, toPos, toStackPos, toItemId));
+		Task task = createPlayerTask(delay, std::bind(&Game::playerUseItemEx, this, playerId, fromPos, fromStackPos, fromItemId, toPos, toStackPos, toItemId));
 		if (it.isRune() || it.type == ITEM_TYPE_POTION) {
-			player->setNextPotionActionTask(task);
+			player->setNextPotionActionTask(std::move(task));
 		} else {
-			player->setNextActionTask(task);
+			player->setNextActionTask(std::move(task));
 		}
 		return;
 	}
@@ -3311,11 +3344,11 @@ void Game::playerUseItem(uint32_t playerId, const Position &pos, uint8_t stackPo
 			if (player->getPathTo(pos, listDir, 0, 1, true, true)) {
 				g_dispatcher().addTask(std::bind(&Game::playerAutoWalk, this, player->getID(), listDir));
 
-				std::shared_ptr<Task> task = createPlayerTask(400, std::bind(&Game::playerUseItem, this, playerId, pos, stackPos, index, itemId));
+				Task task = createPlayerTask(400, std::bind(&Game::playerUseItem, this, playerId, pos, stackPos, index, itemId));
 				if (it.isRune() || it.type == ITEM_TYPE_POTION) {
-					player->setNextPotionActionTask(task);
+					player->setNextPotionActionTask(std::move(task));
 				} else {
-					player->setNextWalkActionTask(task);
+					player->setNextWalkActionTask(std::move(task));
 				}
 				return;
 			}
@@ -3337,11 +3370,11 @@ void Game::playerUseItem(uint32_t playerId, const Position &pos, uint8_t stackPo
 		if (it.isRune() || it.type == ITEM_TYPE_POTION) {
 			delay = player->getNextPotionActionTime();
 		}
-		std::shared_ptr<Task> task = createPlayerTask(delay, std::bind(&Game::playerUseItem, this, playerId, pos, stackPos, index, itemId));
+		Task task = createPlayerTask(delay, std::bind(&Game::playerUseItem, this, playerId, pos, stackPos, index, itemId));
 		if (it.isRune() || it.type == ITEM_TYPE_POTION) {
-			player->setNextPotionActionTask(task);
+			player->setNextPotionActionTask(std::move(task));
 		} else {
-			player->setNextActionTask(task);
+			player->setNextActionTask(std::move(task));
 		}
 		return;
 	}
@@ -3445,11 +3478,11 @@ void Game::playerUseWithCreature(uint32_t playerId, const Position &fromPos, uin
 			if (player->getPathTo(walkToPos, listDir, 0, 1, true, true)) {
 				g_dispatcher().addTask(std::bind(&Game::playerAutoWalk, this, player->getID(), listDir));
 
-				std::shared_ptr<Task> task = createPlayerTask(400, std::bind(&Game::playerUseWithCreature, this, playerId, itemPos, itemStackPos, creatureId, itemId));
+				Task task = createPlayerTask(400, std::bind(&Game::playerUseWithCreature, this, playerId, itemPos, itemStackPos, creatureId, itemId));
 				if (it.isRune() || it.type == ITEM_TYPE_POTION) {
-					player->setNextPotionActionTask(task);
+					player->setNextPotionActionTask(std::move(task));
 				} else {
-					player->setNextWalkActionTask(task);
+					player->setNextWalkActionTask(std::move(task));
 				}
 			} else {
 				player->sendCancelMessage(RETURNVALUE_THEREISNOWAY);
@@ -3471,12 +3504,12 @@ void Game::playerUseWithCreature(uint32_t playerId, const Position &fromPos, uin
 		if (it.isRune() || it.type == ITEM_TYPE_POTION) {
 			delay = player->getNextPotionActionTime();
 		}
-		std::shared_ptr<Task> task = createPlayerTask(delay, std::bind(&Game::playerUseWithCreature, this, playerId, fromPos, fromStackPos, creatureId, itemId));
+		Task task = createPlayerTask(delay, std::bind(&Game::playerUseWithCreature, this, playerId, fromPos, fromStackPos, creatureId, itemId));
 
 		if (it.isRune() || it.type == ITEM_TYPE_POTION) {
-			player->setNextPotionActionTask(task);
+			player->setNextPotionActionTask(std::move(task));
 		} else {
-			player->setNextActionTask(task);
+			player->setNextActionTask(std::move(task));
 		}
 		return;
 	}
@@ -3586,8 +3619,8 @@ void Game::playerRotateItem(uint32_t playerId, const Position &pos, uint8_t stac
 		if (player->getPathTo(pos, listDir, 0, 1, true, true)) {
 			g_dispatcher().addTask(std::bind(&Game::playerAutoWalk, this, player->getID(), listDir));
 
-			std::shared_ptr<Task> task = createPlayerTask(400, std::bind(&Game::playerRotateItem, this, playerId, pos, stackPos, itemId));
-			player->setNextWalkActionTask(task);
+			Task task = createPlayerTask(400, std::bind(&Game::playerRotateItem, this, playerId, pos, stackPos, itemId));
+			player->setNextWalkActionTask(std::move(task));
 		} else {
 			player->sendCancelMessage(RETURNVALUE_THEREISNOWAY);
 		}
@@ -3626,13 +3659,13 @@ void Game::playerConfigureShowOffSocket(uint32_t playerId, const Position &pos,
 		std::forward_list<Direction> listDir;
 		if (player->getPathTo(pos, listDir, 0, 1, true, false)) {
 			g_dispatcher().addTask(std::bind(&Game::playerAutoWalk, this, player->getID(), listDir));
-			std::shared_ptr<Task> task;
+			Task task;
 			if (isPodiumOfRenown) {
 				task = createPlayerTask(400, std::bind_front(&Player::sendPodiumWindow, player, item, pos, itemId, stackPos));
 			} else {
 				task = createPlayerTask(400, std::bind_front(&Player::sendMonsterPodiumWindow, player, item, pos, itemId, stackPos));
 			}
-			player->setNextWalkActionTask(task);
+			player->setNextWalkActionTask(std::move(task));
 		} else {
 			player->sendCancelMessage(RETURNVALUE_THEREISNOWAY);
 		}
@@ -3673,8 +3706,8 @@ void Game::playerSetShowOffSocket(uint32_t playerId, Outfit_t &outfit, const Pos
 		std::forward_list<Direction> listDir;
 		if (player->getPathTo(pos, listDir, 0, 1, true, false)) {
 			g_dispatcher().addTask(std::bind(&Game::playerAutoWalk, this, player->getID(), listDir));
-			std::shared_ptr<Task> task = createPlayerTask(400, std::bind(&Game::playerBrowseField, this, playerId, pos));
-			player->setNextWalkActionTask(task);
+			Task task = createPlayerTask(400, std::bind(&Game::playerBrowseField, this, playerId, pos));
+			player->setNextWalkActionTask(std::move(task));
 		} else {
 			player->sendCancelMessage(RETURNVALUE_THEREISNOWAY);
 		}
@@ -3808,8 +3841,8 @@ void Game::playerWrapableItem(uint32_t playerId, const Position &pos, uint8_t st
 		if (player->getPathTo(pos, listDir, 0, 1, true, true)) {
 			g_dispatcher().addTask(std::bind(&Game::playerAutoWalk, this, player->getID(), listDir));
 
-			std::shared_ptr<Task> task = createPlayerTask(400, std::bind(&Game::playerWrapableItem, this, playerId, pos, stackPos, itemId));
-			player->setNextWalkActionTask(task);
+			Task task = createPlayerTask(400, std::bind(&Game::playerWrapableItem, this, playerId, pos, stackPos, itemId));
+			player->setNextWalkActionTask(std::move(task));
 		} else {
 			player->sendCancelMessage(RETURNVALUE_THEREISNOWAY);
 		}
@@ -3976,8 +4009,8 @@ void Game::playerBrowseField(uint32_t playerId, const Position &pos) {
 		std::forward_list<Direction> listDir;
 		if (player->getPathTo(pos, listDir, 0, 1, true, true)) {
 			g_dispatcher().addTask(std::bind(&Game::playerAutoWalk, this, player->getID(), listDir));
-			std::shared_ptr<Task> task = createPlayerTask(400, std::bind(&Game::playerBrowseField, this, playerId, pos));
-			player->setNextWalkActionTask(task);
+			Task task = createPlayerTask(400, std::bind(&Game::playerBrowseField, this, playerId, pos));
+			player->setNextWalkActionTask(std::move(task));
 		} else {
 			player->sendCancelMessage(RETURNVALUE_THEREISNOWAY);
 		}
@@ -4222,8 +4255,8 @@ void Game::playerRequestTrade(uint32_t playerId, const Position &pos, uint8_t st
 		if (player->getPathTo(pos, listDir, 0, 1, true, true)) {
 			g_dispatcher().addTask(std::bind(&Game::playerAutoWalk, this, player->getID(), listDir));
 
-			std::shared_ptr<Task> task = createPlayerTask(400, std::bind(&Game::playerRequestTrade, this, playerId, pos, stackPos, tradePlayerId, itemId));
-			player->setNextWalkActionTask(task);
+			Task task = createPlayerTask(400, std::bind(&Game::playerRequestTrade, this, playerId, pos, stackPos, tradePlayerId, itemId));
+			player->setNextWalkActionTask(std::move(task));
 		} else {
 			player->sendCancelMessage(RETURNVALUE_THEREISNOWAY);
 		}
@@ -4764,8 +4797,8 @@ void Game::playerQuickLoot(uint32_t playerId, const Position &pos, uint16_t item
 
 	if (!autoLoot && !player->canDoAction()) {
 		uint32_t delay = player->getNextActionTime();
-		std::shared_ptr<Task> task = createPlayerTask(delay, std::bind(&Game::playerQuickLoot, this, player->getID(), pos, itemId, stackPos, defaultItem, lootAllCorpses, autoLoot));
-		player->setNextActionTask(task);
+		Task task = createPlayerTask(delay, std::bind(&Game::playerQuickLoot, this, player->getID(), pos, itemId, stackPos, defaultItem, lootAllCorpses, autoLoot));
+		player->setNextActionTask(std::move(task));
 		return;
 	}
 
@@ -4775,8 +4808,8 @@ void Game::playerQuickLoot(uint32_t playerId, const Position &pos, uint16_t item
 			std::forward_list<Direction> listDir;
 			if (player->getPathTo(pos, listDir, 0, 1, true, true)) {
 				g_dispatcher().addTask(std::bind(&Game::playerAutoWalk, this, player->getID(), listDir));
-				std::shared_ptr<Task> task = createPlayerTask(0, std::bind(&Game::playerQuickLoot, this, player->getID(), pos, itemId, stackPos, defaultItem, lootAllCorpses, autoLoot));
-				player->setNextWalkActionTask(task);
+				Task task = createPlayerTask(0, std::bind(&Game::playerQuickLoot, this, player->getID(), pos, itemId, stackPos, defaultItem, lootAllCorpses, autoLoot));
+				player->setNextWalkActionTask(std::move(task));
 			} else {
 				player->sendCancelMessage(RETURNVALUE_THEREISNOWAY);
 			}
@@ -5587,8 +5620,8 @@ void Game::playerSpeakToNpc(Player* player, const std::string &text) {
 	player->updateUIExhausted();
 }
 
-std::shared_ptr<Task> Game::createPlayerTask(uint32_t delay, std::function<void(void)> f) {
-	return Player::createPlayerTask(delay, f);
+Task Game::createPlayerTask(uint32_t delay, Task &&task) {
+	return Player::createPlayerTask(delay, std::move(task));
 }
 
 //--
@@ -7393,6 +7426,7 @@ void Game::shutdown() {
 	}
 
 	ConnectionManager::getInstance().closeAll();
+	OutputMessageBlockPool::logStats();
 
 	g_logger().info("Done!");
 }
@@ -7902,121 +7936,17 @@ void Game::playerCyclopediaCharacterInfo(Player* player, uint32_t characterID, C
 }
 
 void Game::playerHighscores(Player* player, HighscoreType_t type, uint8_t category, uint32_t vocation, const std::string &, uint16_t page, uint8_t entriesPerPage) {
-	if (player->hasAsyncOngoingTask(PlayerAsyncTask_Highscore)) {
-		return;
-	}
-
-	std::string categoryName;
-	switch (category) {
-		case HIGHSCORE_CATEGORY_FIST_FIGHTING:
-			categoryName = "skill_fist";
-			break;
-		case HIGHSCORE_CATEGORY_CLUB_FIGHTING:
-			categoryName = "skill_club";
-			break;
-		case HIGHSCORE_CATEGORY_SWORD_FIGHTING:
-			categoryName = "skill_sword";
-			break;
-		case HIGHSCORE_CATEGORY_AXE_FIGHTING:
-			categoryName = "skill_axe";
-			break;
-		case HIGHSCORE_CATEGORY_DISTANCE_FIGHTING:
-			categoryName = "skill_dist";
-			break;
-		case HIGHSCORE_CATEGORY_SHIELDING:
-			categoryName = "skill_shielding";
-			break;
-		case HIGHSCORE_CATEGORY_FISHING:
-			categoryName = "skill_fishing";
-			break;
-		case HIGHSCORE_CATEGORY_MAGIC_LEVEL:
-			categoryName = "maglevel";
-			break;
-		default: {
-			category = HIGHSCORE_CATEGORY_EXPERIENCE;
-			categoryName = "experience";
-			break;
-		}
+	if (category >= IOHighscores::CATEGORY_COUNT) {
+		category = HIGHSCORE_CATEGORY_EXPERIENCE;
 	}
 
-	std::ostringstream query;
-	if (type == HIGHSCORE_GETENTRIES) {
-		uint32_t startPage = (static_cast<uint32_t>(page - 1) * static_cast<uint32_t>(entriesPerPage));
-		uint32_t endPage = startPage + static_cast<uint32_t>(entriesPerPage);
-		query << "SELECT *, @row AS `entries`, " << page << " AS `page` FROM (SELECT *, (@row := @row + 1) AS `rn` FROM (SELECT `id`, `name`, `level`, `vocation`, `" << categoryName << "` AS `points`, @curRank := IF(@prevRank = `" << categoryName << "`, @curRank, IF(@prevRank := `" << categoryName << "`, @curRank + 1, @curRank + 1)) AS `rank` FROM `players` `p`, (SELECT @curRank := 0, @prevRank := NULL, @row := 0) `r` WHERE `group_id` < " << static_cast<int>(account::GROUP_TYPE_GAMEMASTER) << " ORDER BY `" << categoryName << "` DESC) `t`";
-		if (vocation != 0xFFFFFFFF) {
-			bool firstVocation = true;
-
-			const auto &vocationsMap = g_vocations().getVocations();
-			for (const auto &it : vocationsMap) {
-				const Vocation &voc = it.second;
-				if (voc.getFromVocation() == vocation) {
-					if (firstVocation) {
-						query << " WHERE `vocation` = " << voc.getId();
-						firstVocation = false;
-					} else {
-						query << " OR `vocation` = " << voc.getId();
-					}
-				}
-			}
-		}
-		query << ") `T` WHERE `rn` > " << startPage << " AND `rn` <= " << endPage;
-	} else if (type == HIGHSCORE_OURRANK) {
-		std::string entriesStr = std::to_string(entriesPerPage);
-		query << "SELECT *, @row AS `entries`, (@ourRow DIV " << entriesStr << ") + 1 AS `page` FROM (SELECT *, (@row := @row + 1) AS `rn`, @ourRow := IF(`id` = " << player->getGUID() << ", @row - 1, @ourRow) AS `rw` FROM (SELECT `id`, `name`, `level`, `vocation`, `" << categoryName << "` AS `points`, @curRank := IF(@prevRank = `" << categoryName << "`, @curRank, IF(@prevRank := `" << categoryName << "`, @curRank + 1, @curRank + 1)) AS `rank` FROM `players` `p`, (SELECT @curRank := 0, @prevRank := NULL, @row := 0, @ourRow := 0) `r` WHERE `group_id` < " << static_cast<int>(account::GROUP_TYPE_GAMEMASTER) << " ORDER BY `" << categoryName << "` DESC) `t`";
-		if (vocation != 0xFFFFFFFF) {
-			bool firstVocation = true;
-
-			const auto &vocationsMap = g_vocations().getVocations();
-			for (const auto &it : vocationsMap) {
-				const Vocation &voc = it.second;
-				if (voc.getFromVocation() == vocation) {
-					if (firstVocation) {
-						query << " WHERE `vocation` = " << voc.getId();
-						firstVocation = false;
-					} else {
-						query << " OR `vocation` = " << voc.getId();
-					}
-				}
-			}
-		}
-		query << ") `T` WHERE `rn` > ((@ourRow DIV " << entriesStr << ") * " << entriesStr << ") AND `rn` <= (((@ourRow DIV " << entriesStr << ") * " << entriesStr << ") + " << entriesStr << ")";
+	const auto highscorePage = g_ioHighscores().getPage(type, category, vocation, player->getGUID(), page, entriesPerPage);
+	if (highscorePage.characters.empty()) {
+		player->sendHighscoresNoData();
+		return;
 	}
 
-	uint32_t playerID = player->getID();
-	std::function<void(DBResult_ptr, bool)> callback = [playerID, category, vocation, entriesPerPage](DBResult_ptr result, bool) {
-		Player* player = g_game().getPlayerByID(playerID);
-		if (!player) {
-			return;
-		}
-
-		player->resetAsyncOngoingTask(PlayerAsyncTask_Highscore);
-		if (!result) {
-			player->sendHighscoresNoData();
-			return;
-		}
-
-		uint16_t page = result->getNumber<uint16_t>("page");
-		uint32_t pages = result->getNumber<uint32_t>("entries");
-		pages += entriesPerPage - 1;
-		pages /= entriesPerPage;
-
-		std::vector<HighscoreCharacter> characters;
-		characters.reserve(result->countResults());
-		do {
-			uint8_t characterVocation;
-			const Vocation* voc = g_vocations().getVocation(result->getNumber<uint16_t>("vocation"));
-			if (voc) {
-				characterVocation = voc->getClientId();
-			} else {
-				characterVocation = 0;
-			}
-			characters.emplace_back(std::move(result->getString("name")), result->getNumber<uint64_t>("points"), result->getNumber<uint32_t>("id"), result->getNumber<uint32_t>("rank"), result->getNumber<uint16_t>("level"), characterVocation);
-		} while (result->next());
-		player->sendHighscores(characters, category, vocation, page, static_cast<uint16_t>(pages));
-	};
-	g_databaseTasks().store(query.str(), callback);
-	player->addAsyncOngoingTask(PlayerAsyncTask_Highscore);
+	player->sendHighscores(highscorePage.characters, category, vocation, highscorePage.page, highscorePage.pages);
 }
 
 void Game::playerReportRuleViolationReport(uint32_t playerId, const std::string &targetName, uint8_t reportType, uint8_t reportReason, const std::string &comment, const std::string &translation) {
@@ -8926,8 +8856,8 @@ void Game::playerSetMonsterPodium(uint32_t playerId, uint32_t monsterRaceId, con
 		if (std::forward_list<Direction> listDir;
 			player->getPathTo(pos, listDir, 0, 1, true, false)) {
 			g_dispatcher().addTask(std::bind_front(&Game::playerAutoWalk, this, player->getID(), listDir));
-			std::shared_ptr<Task> task = createPlayerTask(400, std::bind_front(&Game::playerBrowseField, this, playerId, pos));
-			player->setNextWalkActionTask(task);
+			Task task = createPlayerTask(400, std::bind_front(&Game::playerBrowseField, this, playerId, pos));
+			player->setNextWalkActionTask(std::move(task));
 		} else {
 			player->sendCancelMessage(RETURNVALUE_THEREISNOWAY);
 		}
@@ -9024,8 +8954,8 @@ void Game::playerRotatePodium(uint32_t playerId, const Position &pos, uint8_t st
 			player->getPathTo(pos, listDir, 0, 1, true, true)) {
 			g_dispatcher().addTask(std::bind_front(&Game::playerAutoWalk, this, player->getID(), listDir));
 
-			std::shared_ptr<Task> task = createPlayerTask(400, std::bind_front(&Game::playerRotatePodium, this, playerId, pos, stackPos, itemId));
-			player->setNextWalkActionTask(task);
+			Task task = createPlayerTask(400, std::bind_front(&Game::playerRotatePodium, this, playerId, pos, stackPos, itemId));
+			player->setNextWalkActionTask(std::move(task));
 		} else {
 			player->sendCancelMessage(RETURNVALUE_THEREISNOWAY);
 		}
@@ -9170,6 +9100,7 @@ void Game::updatePlayerSaleItems(uint32_t playerId) {
 void Game::addPlayer(Player* player) {
 	const std::string &lowercase_name = asLowerCaseString(player->getName());
 	mappedPlayerNames[lowercase_name] = player;
+	mappedPlayerGuids[player->getGUID()] = player;
 	wildcardTree.insert(lowercase_name);
 	players[player->getID()] = player;
 }
@@ -9177,6 +9108,7 @@ void Game::addPlayer(Player* player) {
 void Game::removePlayer(Player* player) {
 	const std::string &lowercase_name = asLowerCaseString(player->getName());
 	mappedPlayerNames.erase(lowercase_name);
+	mappedPlayerGuids.erase(player->getGUID());
 	wildcardTree.remove(lowercase_name);
 	players.erase(player->getID());
 }
@@ -9523,7 +9455,7 @@ uint32_t Game::makeFiendishMonster(uint32_t forgeableMonsterId /* = 0*/, bool cr
 			finalTime,
 			std::bind_front(&Game::updateFiendishMonsterStatus, this, monster->getID(), monster->getName())
 		);
-		forgeMonsterEventIds[monster->getID()] = g_scheduler().addEvent(schedulerTask);
+		forgeMonsterEventIds[monster->getID()] = g_scheduler().addEvent(std::move(schedulerTask));
 		return monster->getID();
 	}
 
@@ -9707,8 +9639,7 @@ void Game::addPlayerUniqueLogin(Player* player) {
 		return;
 	}
 
-	const std::string &lowercase_name = asLowerCaseString(player->getName());
-	m_uniqueLoginPlayerNames[lowercase_name] = player;
+	m_uniqueLoginPlayerNames[player->getName()] = player;
 }
 
 Player* Game::getPlayerUniqueLogin(const std::string &playerName) const {
@@ -9717,7 +9648,7 @@ Player* Game::getPlayerUniqueLogin(const std::string &playerName) const {
 		return nullptr;
 	}
 
-	auto it = m_uniqueLoginPlayerNames.find(asLowerCaseString(playerName));
+	auto it = m_uniqueLoginPlayerNames.find(playerName);
 	return (it != m_uniqueLoginPlayerNames.end()) ? it->second : nullptr;
 }
 
@@ -9727,8 +9658,7 @@ void Game::removePlayerUniqueLogin(const std::string &playerName) {
 		return;
 	}
 
-	const std::string &lowercase_name = asLowerCaseString(playerName);
-	m_uniqueLoginPlayerNames.erase(lowercase_name);
+	m_uniqueLoginPlayerNames.erase(playerName);
 }
 
 void Game::removePlayerUniqueLogin(Player* player) {
@@ -9737,8 +9667,7 @@ void Game::removePlayerUniqueLogin(Player* player) {
 		return;
 	}
 
-	const std::string &lowercase_name = asLowerCaseString(player->getName());
-	m_uniqueLoginPlayerNames.erase(lowercase_name);
+	m_uniqueLoginPlayerNames.erase(player->getName());
 }
 
 void Game::playerCheckActivity(const std::string &playerName, int interval) {
@@ -9817,28 +9746,28 @@ const std::unique_ptr<IOWheel> &Game::getIOWheel() const {
 	return m_IOWheel;
 }
 
-template <typename T>
-phmap::parallel_flat_hash_set<T> setDifference(const phmap::parallel_flat_hash_set<T> &setA, const phmap::parallel_flat_hash_set<T> &setB) {
-	phmap::parallel_flat_hash_set<T> setResult;
-	for (const auto &elem : setA) {
-		if (setB.find(elem) == setB.end()) {
-			setResult.insert(elem);
+// Zone lists hold a handful of entries, a linear search beats hashing them
+static ZoneList zoneDifference(const ZoneList &zonesA, const ZoneList &zonesB) {
+	ZoneList result;
+	for (const auto &zone : zonesA) {
+		if (std::find(zonesB.begin(), zonesB.end(), zone) == zonesB.end()) {
+			result.push_back(zone);
 		}
 	}
-	return setResult;
+	return result;
 }
 
-ReturnValue Game::onCreatureZoneChange(Creature* creature, const phmap::parallel_flat_hash_set<std::shared_ptr<Zone>> &fromZones, const phmap::parallel_flat_hash_set<std::shared_ptr<Zone>> &toZones) {
+ReturnValue Game::onCreatureZoneChange(Creature* creature, const ZoneList &fromZones, const ZoneList &toZones) {
 	if (!creature) {
 		return RETURNVALUE_NOTPOSSIBLE;
 	}
 
 	// fromZones - toZones = zones that creature left
-	auto zonesLeft = setDifference(fromZones, toZones);
+	auto zonesLeft = zoneDifference(fromZones, toZones);
 	// toZones - fromZones = zones that creature entered
-	auto zonesEntered = setDifference(toZones, fromZones);
+	auto zonesEntered = zoneDifference(toZones, fromZones);
 	// intersection of fromZones and toZones = zones that creature is still in
-	auto zonesStillIn = setDifference(fromZones, zonesLeft);
+	auto zonesStillIn = zoneDifference(fromZones, zonesLeft);
 
 	for (const auto &zone : zonesStillIn) {
 		// creatureAdded is idempotent, so we can just call it. This is useful for
@@ -643,12 +643,22 @@ private:
 	std::set<uint32_t> fiendishMonsters;
 	std::set<uint32_t> influencedMonsters;
 	void checkImbuements();
+	/**
+	 * Snapshots players, guilds and houses on the game thread and writes them
+	 * later from the thread pool, spread over SAVE_ASYNC_WINDOW.
+	 * \warning The rows are written as they were at the snapshot: a change made
+	 * directly in the database to a saved player, guild or house (`houses` owner,
+	 * paid, warnings, name, town_id, rent, size and beds, and `house_lists`)
+	 * between the snapshot and its write is overwritten, as a sync save would
+	 * overwrite it. Tools editing them must do so while the server is offline.
+	 */
+	void saveGameStateAsync();
 	bool playerSaySpell(Player* player, SpeakClasses type, const std::string &text);
 	void playerWhisper(Player* player, const std::string &text);
 	bool playerYell(Player* player, const std::string &text);
 	bool playerSpeakTo(Player* player, SpeakClasses type, const std::string &receiver, const std::string &text);
 	void playerSpeakToNpc(Player* player, const std::string &text);
-	std::shared_ptr<Task> createPlayerTask(uint32_t delay, std::function<void(void)> f);
+	Task createPlayerTask(uint32_t delay, Task &&task);
 
 	/**
 	 * Player wants to loot a corpse
@@ -733,9 +743,10 @@ private:
 	 */
 	ReturnValue collectRewardChestItems(Player* player, uint32_t maxMoveItems = 0);
 
-	phmap::flat_hash_map<std::string, Player*> m_uniqueLoginPlayerNames;
+	CaseInsensitiveMap<Player*> m_uniqueLoginPlayerNames;
 	phmap::flat_hash_map<uint32_t, Player*> players;
-	phmap::flat_hash_map<std::string, Player*> mappedPlayerNames;
+	CaseInsensitiveMap<Player*> mappedPlayerNames;
+	phmap::flat_hash_map<uint32_t, Player*> mappedPlayerGuids;
 	phmap::flat_hash_map<uint32_t, std::shared_ptr<Guild>> guilds;
 	phmap::flat_hash_map<uint16_t, Item*> uniqueItems;
 	std::map<uint32_t, uint32_t> stages;
@@ -853,7 +864,7 @@ private:
 
 	void unwrapItem(Item* item, uint16_t unWrapId, House* house, Player* player);
 
-	ReturnValue onCreatureZoneChange(Creature* creature, const phmap::parallel_flat_hash_set<std::shared_ptr<Zone>> &fromZones, const phmap::parallel_flat_hash_set<std::shared_ptr<Zone>> &toZones);
+	ReturnValue onCreatureZoneChange(Creature* creature, const ZoneList &fromZones, const ZoneList &toZones);
 
 	// Variable members (m_)
 	std::unique_ptr<IOWheel> m_IOWheel;
@@ -9,50 +9,109 @@
 
 #include "pch.hpp"
 
-#include "lib/thread/thread_pool.hpp"
 #include "game/scheduling/dispatcher.hpp"
-#include "game/scheduling/task.hpp"
+#include "game/scheduling/scheduler.hpp"
+#include "utils/tools.hpp"
 
-Dispatcher::Dispatcher(ThreadPool &threadPool) :
-	threadPool(threadPool) { }
+Dispatcher::Dispatcher(Logger &logger, Scheduler &scheduler) :
+	logger(logger), scheduler(scheduler) {
+	thread = std::jthread([this](const std::stop_token &stopToken) {
+		threadMain(stopToken);
+	});
+}
 
 Dispatcher &Dispatcher::getInstance() {
 	return inject<Dispatcher>();
 }
 
-void Dispatcher::addTask(std::function<void(void)> f, uint32_t expiresAfterMs /* = 0*/) {
-	addTask(std::make_shared<Task>(std::move(f)), expiresAfterMs);
-}
+void Dispatcher::addTask(Task &&task, uint32_t expiresAfterMs /* = 0*/) {
+	const int64_t expiresAt = expiresAfterMs == 0 ? 0 : OTSYS_TIME() + expiresAfterMs;
 
-void Dispatcher::addTask(const std::shared_ptr<Task> &task, uint32_t expiresAfterMs /* = 0*/) {
-	if (expiresAfterMs == 0) {
-		threadPool.addLoad([this, task]() {
-			std::lock_guard lockClass(threadSafetyMutex);
-			++dispatcherCycle;
-			(*task)();
-		});
+	bool wasEmpty;
+	{
+		std::scoped_lock lock(queueMutex);
+		wasEmpty = incomingTasks.empty();
+		incomingTasks.push_back({ std::move(task), expiresAt, expiresAfterMs });
+	}
+
+	// The game thread only sleeps when the queue is empty
+	if (wasEmpty) {
+		queueSignal.notify_one();
+	}
+}
 
+void Dispatcher::shutdown() {
+	if (!thread.joinable()) {
 		return;
-	};
+	}
+
+	logger.info("Shutting down dispatcher...");
+
+	thread.request_stop();
+	queueSignal.notify_all();
+
+	// A task running on the game thread cannot join itself
+	if (!isGameThread()) {
+		thread.join();
+	}
+}
+
+void Dispatcher::threadMain(const std::stop_token &stopToken) {
+	while (!stopToken.stop_requested()) {
+		const int64_t nextEventDelay = scheduler.collectExpiredEvents(expiredEvents);
+		{
+			std::unique_lock lock(queueMutex);
+			const auto hasTasks = [this] { return !incomingTasks.empty(); };
+			// Only sleep when no expired event is waiting, at most until the next occupied wheel slot
+			if (expiredEvents.empty()) {
+				if (nextEventDelay < 0) {
+					queueSignal.wait(lock, stopToken, hasTasks);
+				} else {
+					queueSignal.wait_for(lock, stopToken, std::chrono::milliseconds(nextEventDelay), hasTasks);
+				}
+			}
 
-	auto timer = std::make_shared<asio::steady_timer>(threadPool.getIoContext());
-	timer->expires_after(std::chrono::milliseconds(expiresAfterMs));
+			if (stopToken.stop_requested()) {
+				break;
+			}
 
-	timer->async_wait([task, expiresAfterMs](const std::error_code &error) {
-		if (error == asio::error::operation_aborted) {
-			return;
+			// Take the whole batch so producers never wait on task execution
+			runningTasks.swap(incomingTasks);
 		}
 
-		g_logger().info("Task was not executed within {} ms, so it was cancelled.", expiresAfterMs);
-	});
+		executeTasks();
+	}
+}
+
+int64_t Dispatcher::getCycleTime() {
+	if (!isGameThread()) {
+		return OTSYS_TIME();
+	}
+
+	if (cycleTimeCycle != dispatcherCycle) {
+		cycleTimeCycle = dispatcherCycle;
+		cycleTime = OTSYS_TIME();
+	}
+	return cycleTime;
+}
 
-	threadPool.addLoad([this, task, timer]() {
-		std::lock_guard lockClass(threadSafetyMutex);
-		if (timer->cancel() <= 0) {
-			return;
+void Dispatcher::executeTasks() {
+	for (auto &event : expiredEvents) {
+		++dispatcherCycle;
+		event();
+	}
+	expiredEvents.clear();
+
+	const int64_t now = OTSYS_TIME();
+	for (auto &[task, expiresAt, expiresAfterMs] : runningTasks) {
+		if (expiresAt != 0 && expiresAt < now) {
+			logger.info("Task was not executed within {} ms, so it was cancelled.", expiresAfterMs);
+			continue;
 		}
 
 		++dispatcherCycle;
-		(*task)();
-	});
-}
\ No newline at end of file
+		task();
+	}
+
+	runningTasks.clear();
+}
@@ -9,20 +9,26 @@
 
 #pragma once
 
-#include "lib/thread/thread_pool.hpp"
+#include "lib/thread/task.hpp"
 
 const int DISPATCHER_TASK_EXPIRATION = 2000;
 
-class Task;
+class Scheduler;
 
 /**
  * Dispatcher allow you to dispatch a task async to be executed
  * in the dispatching thread. You can dispatch with an expiration
  * time, after which the task will be ignored.
+ *
+ * All game logic runs on a single thread owned by the dispatcher.
+ * Any thread may enqueue tasks, the game thread drains the whole
+ * queue at once and runs the batch without holding any lock.
+ * Between batches it also advances the scheduler's timer wheel
+ * and runs every expired event.
  */
 class Dispatcher {
 public:
-	explicit Dispatcher(ThreadPool &threadPool);
+	Dispatcher(Logger &logger, Scheduler &scheduler);
 
 	// Ensures that we don't accidentally copy it
 	Dispatcher(const Dispatcher &) = delete;
@@ -30,17 +36,51 @@ public:
 
 	static Dispatcher &getInstance();
 
-	void addTask(std::function<void(void)> f, uint32_t expiresAfterMs = 0);
-	void addTask(const std::shared_ptr<Task> &task, uint32_t expiresAfterMs = 0);
+	void addTask(Task &&task, uint32_t expiresAfterMs = 0);
+
+	void shutdown();
+
+	[[nodiscard]] bool isGameThread() const {
+		return std::this_thread::get_id() == thread.get_id();
+	}
 
 	[[nodiscard]] uint64_t getDispatcherCycle() const {
 		return dispatcherCycle;
 	}
 
+	/**
+	 * OTSYS_TIME() read once per dispatcher cycle, so the many time checks
+	 * of a single task or event share one clock read.
+	 * Other threads always get a fresh read.
+	 */
+	[[nodiscard]] int64_t getCycleTime();
+
 private:
-	ThreadPool &threadPool;
+	struct QueuedTask {
+		Task task;
+		// Zero means the task never expires
+		int64_t expiresAt = 0;
+		uint32_t expiresAfterMs = 0;
+	};
+
+	void threadMain(const std::stop_token &stopToken);
+	void executeTasks();
+
+	Logger &logger;
+	Scheduler &scheduler;
+
+	std::mutex queueMutex;
+	std::condition_variable_any queueSignal;
+	std::vector<QueuedTask> incomingTasks;
+
+	// Only touched by the game thread
+	std::vector<QueuedTask> runningTasks;
+	std::vector<Task> expiredEvents;
 	uint64_t dispatcherCycle = 0;
-	std::mutex threadSafetyMutex;
+	uint64_t cycleTimeCycle = std::numeric_limits<uint64_t>::max();
+	int64_t cycleTime = 0;
+
+	std::jthread thread;
 };
 
 constexpr auto g_dispatcher = Dispatcher::getInstance;
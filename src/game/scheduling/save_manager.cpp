@@ -0,0 +1,185 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2023 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "pch.hpp"
+
+#include "game/scheduling/save_manager.hpp"
+#include "game/scheduling/dispatcher.hpp"
+#include "game/scheduling/scheduler.hpp"
+#include "creatures/players/player.hpp"
+#include "io/iologindata.hpp"
+
+SaveManager::SaveManager(ThreadPool &threadPool, Logger &logger) :
+	threadPool(threadPool), logger(logger) {
+}
+
+SaveManager &SaveManager::getInstance() {
+	return inject<SaveManager>();
+}
+
+bool SaveManager::beginSave() {
+	if (isWriting()) {
+		logger.warn("Previous background save is still being written, {}/{} done, skipping this one", completedWrites, writes.size());
+		return false;
+	}
+
+	completedWrites = 0;
+	failedWrites = 0;
+	statements = 0;
+	bytes = 0;
+	reportedQuarter = 0;
+	saveStart = OTSYS_TIME();
+	return true;
+}
+
+void SaveManager::addPlayer(Player* player) {
+	auto pendingWrite = std::make_shared<PendingWrite>();
+	if (!IOLoginData::snapshotPlayer(player, pendingWrite->batch)) {
+		logger.error("Failed to snapshot player {} for the background save", player->getName());
+		return;
+	}
+
+	player->incrementReferenceCounter();
+	pendingWrite->player = player;
+	pendingWrite->playerGuid = player->getGUID();
+	playerWrites[pendingWrite->playerGuid] = pendingWrite;
+	writes.emplace_back(std::move(pendingWrite));
+}
+
+void SaveManager::addWorld(const std::function<void()> &record) {
+	auto pendingWrite = std::make_shared<PendingWrite>();
+	{
+		DBRecordScope recordScope(pendingWrite->batch);
+		record();
+	}
+	writes.emplace_back(std::move(pendingWrite));
+}
+
+void SaveManager::startWrites(uint32_t writeWindowMs) {
+	for (const auto &pendingWrite : writes) {
+		statements += pendingWrite->batch.size();
+		bytes += pendingWrite->batch.getBytes();
+	}
+
+	writeStart = OTSYS_TIME();
+	snapshotTime = writeStart - saveStart;
+	logger.info("Save snapshot of {} batches taken in {} ms, writing {} statements ({} kB) over {} seconds", writes.size(), snapshotTime, statements, bytes / 1024, writeWindowMs / 1000);
+
+	if (writes.empty()) {
+		return;
+	}
+
+	// Each slice hands its share of the batches to the thread pool, one slice every WRITE_SLICE_INTERVAL
+	const size_t slices = std::clamp<size_t>(writeWindowMs / WRITE_SLICE_INTERVAL, 1, writes.size());
+	for (size_t slice = 0; slice < slices; ++slice) {
+		const size_t first = writes.size() * slice / slices;
+		const size_t last = writes.size() * (slice + 1) / slices;
+		std::vector<PendingWrite_ptr> sliceWrites(writes.begin() + first, writes.begin() + last);
+		auto writeSlice = [this, sliceWrites = std::move(sliceWrites)]() {
+			for (const auto &pendingWrite : sliceWrites) {
+				threadPool.addLoad([this, pendingWrite]() {
+					write(pendingWrite);
+				});
+			}
+		};
+
+		const auto delay = static_cast<uint32_t>(static_cast<uint64_t>(writeWindowMs) * slice / slices);
+		if (delay == 0) {
+			writeSlice();
+		} else {
+			g_scheduler().addEvent(delay, std::move(writeSlice));
+		}
+	}
+}
+
+void SaveManager::write(const PendingWrite_ptr &pendingWrite) {
+	// Thread pool, unless the game thread already flushed this batch
+	if (pendingWrite->claimed.exchange(true)) {
+		return;
+	}
+
+	pendingWrite->success = pendingWrite->batch.execute();
+	pendingWrite->written.store(true, std::memory_order_release);
+	pendingWrite->written.notify_all();
+
+	g_dispatcher().addTask([this, pendingWrite]() {
+		complete(pendingWrite);
+	});
+}
+
+void SaveManager::flushPlayer(const Player* player) {
+	auto it = playerWrites.find(player->getGUID());
+	if (it != playerWrites.end()) {
+		// Copied, completing the write erases it from playerWrites
+		const PendingWrite_ptr pendingWrite = it->second;
+		flush(pendingWrite);
+	}
+}
+
+void SaveManager::flushAll() {
+	const auto pendingWrites = writes;
+	for (const auto &pendingWrite : pendingWrites) {
+		flush(pendingWrite);
+	}
+}
+
+void SaveManager::flush(const PendingWrite_ptr &pendingWrite) {
+	if (pendingWrite->completed) {
+		return;
+	}
+
+	if (!pendingWrite->claimed.exchange(true)) {
+		pendingWrite->success = pendingWrite->batch.execute();
+		pendingWrite->written.store(true, std::memory_order_release);
+	} else {
+		// Already being written on the thread pool, which never needs the game thread to finish it
+		pendingWrite->written.wait(false, std::memory_order_acquire);
+	}
+	complete(pendingWrite);
+}
+
+void SaveManager::complete(const PendingWrite_ptr &pendingWrite) {
+	if (pendingWrite->completed) {
+		return;
+	}
+	pendingWrite->completed = true;
+
+	if (!pendingWrite->success) {
+		++failedWrites;
+	}
+
+	if (Player* player = std::exchange(pendingWrite->player, nullptr)) {
+		if (pendingWrite->success) {
+			player->saveState.commit();
+		} else {
+			// Nothing of the batch reached the database, the next save must write it all again
+			player->saveState.discard();
+		}
+
+		auto it = playerWrites.find(pendingWrite->playerGuid);
+		if (it != playerWrites.end() && it->second == pendingWrite) {
+			playerWrites.erase(it);
+		}
+		player->decrementReferenceCounter();
+	}
+
+	++completedWrites;
+	const auto quarter = static_cast<uint8_t>(completedWrites * 4 / writes.size());
+	if (quarter > reportedQuarter && completedWrites < writes.size()) {
+		reportedQuarter = quarter;
+		logger.info("Background save {}% written ({}/{})", quarter * 25, completedWrites, writes.size());
+	}
+
+	if (completedWrites == writes.size()) {
+		const int64_t now = OTSYS_TIME();
+		logger.info("Background save finished: {} batches, {} statements, {} failed, snapshot {} ms, writes {} ms", writes.size(), statements, failedWrites, snapshotTime, now - writeStart);
+		Database::getInstance().logPoolMetrics();
+		writes.clear();
+	}
+}
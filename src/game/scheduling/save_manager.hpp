@@ -0,0 +1,104 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2023 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include "database/database.hpp"
+#include "lib/thread/thread_pool.hpp"
+
+class Player;
+
+/**
+ * Background saves. The game thread only records the statements a save
+ * would run into one batch per player, plus one for guilds and houses,
+ * the batches are then written by the thread pool, optionally spread over
+ * a time window.
+ *
+ * A player whose batch has not been written yet must not be saved again
+ * before it, so every other save of that player flushes it first.
+ */
+class SaveManager {
+public:
+	SaveManager(ThreadPool &threadPool, Logger &logger);
+
+	// Ensures that we don't accidentally copy it
+	SaveManager(const SaveManager &) = delete;
+	SaveManager &operator=(const SaveManager &) = delete;
+
+	static SaveManager &getInstance();
+
+	/**
+	 * Starts a new background save.
+	 * \returns false if the writes of the previous one are still running.
+	 */
+	bool beginSave();
+	void addPlayer(Player* player);
+	/**
+	 * Records the statements record runs into the save, used for guilds and houses.
+	 */
+	void addWorld(const std::function<void()> &record);
+	/**
+	 * Hands the recorded batches to the thread pool, spread over writeWindowMs.
+	 */
+	void startWrites(uint32_t writeWindowMs);
+
+	/**
+	 * Writes the player's pending batch on the calling thread,
+	 * or waits for the thread pool to finish writing it.
+	 */
+	void flushPlayer(const Player* player);
+	void flushAll();
+
+	bool isWriting() const {
+		return !writes.empty();
+	}
+	size_t getWrittenCount() const {
+		return completedWrites;
+	}
+	size_t getTotalCount() const {
+		return writes.size();
+	}
+
+private:
+	static constexpr uint32_t WRITE_SLICE_INTERVAL = 250;
+
+	struct PendingWrite {
+		DBStatementBatch batch;
+		// Holds a reference until the write completed, nullptr for the world batch
+		Player* player = nullptr;
+		uint32_t playerGuid = 0;
+
+		std::atomic<bool> claimed = false;
+		std::atomic<bool> written = false;
+		bool success = false;
+		bool completed = false;
+	};
+	using PendingWrite_ptr = std::shared_ptr<PendingWrite>;
+
+	void write(const PendingWrite_ptr &pendingWrite);
+	void flush(const PendingWrite_ptr &pendingWrite);
+	void complete(const PendingWrite_ptr &pendingWrite);
+
+	ThreadPool &threadPool;
+	Logger &logger;
+
+	// Game thread only
+	std::vector<PendingWrite_ptr> writes;
+	phmap::flat_hash_map<uint32_t, PendingWrite_ptr> playerWrites;
+	size_t completedWrites = 0;
+	size_t failedWrites = 0;
+	size_t statements = 0;
+	size_t bytes = 0;
+	int64_t saveStart = 0;
+	int64_t snapshotTime = 0;
+	int64_t writeStart = 0;
+	uint8_t reportedQuarter = 0;
+};
+
+constexpr auto g_saveManager = SaveManager::getInstance;
@@ -9,56 +9,120 @@
 
 #include "pch.hpp"
 
-#include "lib/thread/thread_pool.hpp"
 #include "game/scheduling/dispatcher.hpp"
 #include "game/scheduling/scheduler.hpp"
-#include "game/scheduling/task.hpp"
-
-Scheduler::Scheduler(ThreadPool &threadPool) :
-	threadPool(threadPool) { }
 
 Scheduler &Scheduler::getInstance() {
 	return inject<Scheduler>();
 }
 
-uint64_t Scheduler::addEvent(uint32_t delay, std::function<void(void)> f) {
-	return addEvent(std::make_shared<Task>(std::move(f), delay));
+int64_t Scheduler::getCurrentTick() {
+	return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+uint64_t Scheduler::addEvent(uint32_t delay, Task &&task) {
+	task.setDelay(delay);
+	return addEvent(std::move(task));
+}
+
+uint64_t Scheduler::addEvent(Task &&task) {
+	if (task.getEventId() == 0) {
+		task.setEventId(++lastEventId);
+	}
+
+	const uint64_t eventId = task.getEventId();
+	if (g_dispatcher().isGameThread()) {
+		insertEvent(std::move(task));
+	} else {
+		g_dispatcher().addTask([this, task = std::move(task)]() mutable { insertEvent(std::move(task)); });
+	}
+
+	return eventId;
 }
 
-uint64_t Scheduler::addEvent(const std::shared_ptr<Task> &task) {
-	if (task->getEventId() == 0) {
-		task->setEventId(++lastEventId);
+void Scheduler::stopEvent(uint64_t eventId) {
+	if (g_dispatcher().isGameThread()) {
+		removeEvent(eventId);
+	} else {
+		g_dispatcher().addTask([this, eventId] { removeEvent(eventId); });
 	}
+}
 
-	threadPool.addLoad([this, task]() {
-		std::lock_guard lockAdd(threadSafetyMutex);
-		auto [item, wasAdded] = eventIds.try_emplace(task->getEventId(), threadPool.getIoContext());
+void Scheduler::insertEvent(Task &&task) {
+	// Events always land in a future slot, so a zero delay runs on the next advance
+	const int64_t expiresAt = std::max(getCurrentTick(), currentTick + 1) + task.getDelay();
+	const auto slot = static_cast<uint32_t>(expiresAt) & WHEEL_MASK;
 
-		asio::steady_timer &timer = item->second;
-		timer.expires_from_now(std::chrono::milliseconds(task->getDelay()));
+	activeEvents[task.getEventId()] = expiresAt;
+	wheel[slot].push_back({ std::move(task), expiresAt });
+	setOccupied(slot);
+}
 
-		timer.async_wait([this, task](const asio::error_code &error) {
-			std::lock_guard lockAsyncCallback(threadSafetyMutex);
-			eventIds.erase(task->getEventId());
+void Scheduler::removeEvent(uint64_t eventId) {
+	// The wheel entry is dropped lazily when its slot is visited
+	activeEvents.erase(eventId);
+}
 
-			if (error == asio::error::operation_aborted || threadPool.getIoContext().stopped()) {
-				return;
+int64_t Scheduler::collectExpiredEvents(std::vector<Task> &expiredEvents) {
+	const int64_t now = getCurrentTick();
+	if (now > currentTick) {
+		// After a full revolution every slot has been visited once already
+		const int64_t steps = std::min<int64_t>(now - currentTick, WHEEL_SLOTS);
+		for (int64_t tick = now - steps + 1; tick <= now; ++tick) {
+			const auto slot = static_cast<uint32_t>(tick) & WHEEL_MASK;
+			if (occupiedSlots[slot >> 6] & (uint64_t { 1 } << (slot & 63))) {
+				collectSlot(slot, now, expiredEvents);
 			}
+		}
+		currentTick = now;
+	}
+
+	return getNextSlotDistance();
+}
+
+void Scheduler::collectSlot(uint32_t slot, int64_t now, std::vector<Task> &expiredEvents) {
+	auto &entries = wheel[slot];
+	size_t kept = 0;
+	for (auto &entry : entries) {
+		const auto it = activeEvents.find(entry.task.getEventId());
+		if (it == activeEvents.end() || it->second != entry.expiresAt) {
+			continue;
+		}
+
+		if (entry.expiresAt > now) {
+			// Not due yet, it will come around on a later revolution
+			entries[kept++] = std::move(entry);
+			continue;
+		}
 
-			g_dispatcher().addTask(task);
-		});
-	});
+		activeEvents.erase(it);
+		expiredEvents.emplace_back(std::move(entry.task));
+	}
 
-	return task->getEventId();
+	entries.resize(kept);
+	if (entries.empty()) {
+		clearOccupied(slot);
+	}
 }
 
-void Scheduler::stopEvent(uint64_t eventId) {
-	threadPool.addLoad([this, eventId]() {
-		std::lock_guard lockClass(threadSafetyMutex);
-		auto it = eventIds.find(eventId);
+int64_t Scheduler::getNextSlotDistance() const {
+	if (activeEvents.empty()) {
+		return -1;
+	}
 
-		if (it != eventIds.end()) {
-			it->second.cancel();
+	// Scan the occupancy bitmap one word at a time, starting right after the current slot
+	auto slot = static_cast<uint32_t>(currentTick + 1) & WHEEL_MASK;
+	int64_t distance = 1;
+	for (uint32_t words = 0; words <= WHEEL_WORDS; ++words) {
+		const uint32_t offset = slot & 63;
+		const uint64_t bits = occupiedSlots[slot >> 6] >> offset;
+		if (bits != 0) {
+			return distance + std::countr_zero(bits);
 		}
-	});
+
+		distance += 64 - offset;
+		slot = (slot + 64 - offset) & WHEEL_MASK;
+	}
+
+	return -1;
 }
@@ -9,19 +9,24 @@
 
 #pragma once
 
-#include "lib/thread/thread_pool.hpp"
+#include "lib/thread/task.hpp"
 
 static constexpr int32_t SCHEDULER_MINTICKS = 50;
 
-class Task;
-
 /**
  * Scheduler allow you to schedule a task async to be executed after a
  * given period. Once the time has passed, scheduler calls the task.
+ *
+ * Events are kept in a hashed timing wheel with one millisecond per slot,
+ * events further away than one revolution simply stay in their slot until
+ * their expiration tick comes around. The wheel is owned by the game thread:
+ * the dispatcher advances it between task batches and runs every expired
+ * event in the same batch. Calls from other threads are forwarded to the
+ * game thread through the dispatcher.
  */
 class Scheduler {
 public:
-	explicit Scheduler(ThreadPool &threadPool);
+	Scheduler() = default;
 
 	// Ensures that we don't accidentally copy it
 	Scheduler(const Scheduler &) = delete;
@@ -29,15 +34,52 @@ public:
 
 	static Scheduler &getInstance();
 
-	uint64_t addEvent(uint32_t delay, std::function<void(void)> f);
-	uint64_t addEvent(const std::shared_ptr<Task> &task);
+	uint64_t addEvent(uint32_t delay, Task &&task);
+	uint64_t addEvent(Task &&task);
 	void stopEvent(uint64_t eventId);
 
+	/**
+	 * Game thread only. Moves every event that expired up to now into expiredEvents,
+	 * returns the milliseconds until the next occupied slot or -1 if the wheel is empty.
+	 */
+	int64_t collectExpiredEvents(std::vector<Task> &expiredEvents);
+
+	[[nodiscard]] size_t getActiveEventCount() const {
+		return activeEvents.size();
+	}
+
 private:
-	ThreadPool &threadPool;
-	std::mutex threadSafetyMutex;
+	static constexpr uint32_t WHEEL_SLOTS = 4096;
+	static constexpr uint32_t WHEEL_MASK = WHEEL_SLOTS - 1;
+	static constexpr uint32_t WHEEL_WORDS = WHEEL_SLOTS / 64;
+
+	struct WheelEntry {
+		Task task;
+		int64_t expiresAt;
+	};
+
+	static int64_t getCurrentTick();
+
+	void insertEvent(Task &&task);
+	void removeEvent(uint64_t eventId);
+	void collectSlot(uint32_t slot, int64_t now, std::vector<Task> &expiredEvents);
+	int64_t getNextSlotDistance() const;
+
+	void setOccupied(uint32_t slot) {
+		occupiedSlots[slot >> 6] |= (uint64_t { 1 } << (slot & 63));
+	}
+	void clearOccupied(uint32_t slot) {
+		occupiedSlots[slot >> 6] &= ~(uint64_t { 1 } << (slot & 63));
+	}
+
 	std::atomic<uint64_t> lastEventId { 0 };
-	std::unordered_map<uint64_t, asio::steady_timer> eventIds;
+
+	// Game thread only
+	std::array<std::vector<WheelEntry>, WHEEL_SLOTS> wheel;
+	std::array<uint64_t, WHEEL_WORDS> occupiedSlots {};
+	// Event id -> expiration tick, an entry missing here or with another tick was cancelled
+	phmap::flat_hash_map<uint64_t, int64_t> activeEvents;
+	int64_t currentTick = getCurrentTick();
 };
 
 constexpr auto g_scheduler = Scheduler::getInstance;
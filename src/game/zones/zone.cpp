@@ -17,6 +17,7 @@
 
 std::map<std::string, std::shared_ptr<Zone>> Zone::zones = {};
 std::mutex Zone::zonesMutex = {};
+phmap::flat_hash_map<uint32_t, std::vector<Zone::SectorArea>> Zone::sectorAreas = {};
 const static std::shared_ptr<Zone> nullZone = nullptr;
 
 const std::shared_ptr<Zone> &Zone::addZone(const std::string &name) {
@@ -34,6 +35,19 @@ const std::shared_ptr<Zone> &Zone::addZone(const std::string &name) {
 }
 
 void Zone::addArea(Area area) {
+	{
+		std::lock_guard lock(zonesMutex);
+		const auto self = shared_from_this();
+		for (uint8_t z = area.from.z; z <= area.to.z; ++z) {
+			for (uint32_t sectorY = area.from.y / ZONE_SECTOR_SIZE; sectorY <= area.to.y / ZONE_SECTOR_SIZE; ++sectorY) {
+				for (uint32_t sectorX = area.from.x / ZONE_SECTOR_SIZE; sectorX <= area.to.x / ZONE_SECTOR_SIZE; ++sectorX) {
+					const auto key = getSectorKey(static_cast<uint16_t>(sectorX * ZONE_SECTOR_SIZE), static_cast<uint16_t>(sectorY * ZONE_SECTOR_SIZE), z);
+					sectorAreas[key].push_back({ area, self });
+				}
+			}
+		}
+	}
+
 	for (const Position &pos : area) {
 		positions.insert(pos);
 		Tile* tile = g_game().map.getTile(pos);
@@ -99,17 +113,24 @@ void Zone::removeNpcs() const {
 void Zone::clearZones() {
 	std::lock_guard lock(zonesMutex);
 	zones.clear();
+	sectorAreas.clear();
 }
 
-phmap::parallel_flat_hash_set<std::shared_ptr<Zone>> Zone::getZones(const Position &postion) {
+ZoneList Zone::getZones(const Position &position) {
+	ZoneList zonesList;
 	std::lock_guard lock(zonesMutex);
-	phmap::parallel_flat_hash_set<std::shared_ptr<Zone>> zonesSet;
-	for (const auto &[_, zone] : zones) {
-		if (zone && zone->isPositionInZone(postion)) {
-			zonesSet.insert(zone);
+	auto it = sectorAreas.find(getSectorKey(position.x, position.y, position.z));
+	if (it == sectorAreas.end()) {
+		return zonesList;
+	}
+
+	for (const auto &[area, zone] : it->second) {
+		// A zone made of overlapping areas is listed once
+		if (area.contains(position) && std::find(zonesList.begin(), zonesList.end(), zone) == zonesList.end()) {
+			zonesList.push_back(zone);
 		}
 	}
-	return zonesSet;
+	return zonesList;
 }
 
 const phmap::parallel_flat_hash_set<std::shared_ptr<Zone>> &Zone::getZones() {
@@ -17,6 +17,12 @@ class Monster;
 class Player;
 class Npc;
 class Item;
+class Zone;
+
+/**
+ * The zones of one position, rarely more than a couple so they are kept inline.
+ */
+using ZoneList = absl::InlinedVector<std::shared_ptr<Zone>, 4>;
 
 struct Area {
 	constexpr Area() = default;
@@ -77,7 +83,7 @@ struct Area {
 	}
 };
 
-class Zone {
+class Zone : public std::enable_shared_from_this<Zone> {
 public:
 	explicit Zone(const std::string &name) :
 		name(name) { }
@@ -110,11 +116,26 @@ public:
 
 	const static std::shared_ptr<Zone> &addZone(const std::string &name);
 	const static std::shared_ptr<Zone> &getZone(const std::string &name);
-	static phmap::parallel_flat_hash_set<std::shared_ptr<Zone>> getZones(const Position &position);
+	static ZoneList getZones(const Position &position);
 	const static phmap::parallel_flat_hash_set<std::shared_ptr<Zone>> &getZones();
 	static void clearZones();
 
 private:
+	/**
+	 * Zone areas are indexed by the ZONE_SECTOR_SIZE x ZONE_SECTOR_SIZE sectors
+	 * they overlap on each floor, a position lookup only tests the areas of its own sector.
+	 */
+	static constexpr uint16_t ZONE_SECTOR_SIZE = 32;
+
+	struct SectorArea {
+		Area area;
+		std::shared_ptr<Zone> zone;
+	};
+
+	static uint32_t getSectorKey(uint16_t x, uint16_t y, uint8_t z) {
+		return (static_cast<uint32_t>(x / ZONE_SECTOR_SIZE) << 16) | (static_cast<uint32_t>(y / ZONE_SECTOR_SIZE) << 4) | z;
+	}
+
 	std::string name;
 	std::set<Position> positions;
 	phmap::parallel_flat_hash_set<Tile*> tiles;
@@ -126,4 +147,5 @@ private:
 
 	static std::mutex zonesMutex;
 	static std::map<std::string, std::shared_ptr<Zone>> zones;
+	static phmap::flat_hash_map<uint32_t, std::vector<SectorArea>> sectorAreas;
 };
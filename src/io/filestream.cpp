@@ -48,9 +48,13 @@ bool FileStream::read(T &ret, bool escape) {
 	std::array<uint8_t, sizeof(T)> array;
 	if (escape) {
 		for (int_fast8_t i = -1; ++i < size;) {
-			if (m_data[m_pos] == OTB::Node::ESCAPE) {
+			if (m_pos < m_data.size() && m_data[m_pos] == OTB::Node::ESCAPE) {
 				++m_pos;
 			}
+			// Escape bytes make the value longer than its size, the data may end before it
+			if (m_pos >= m_data.size()) {
+				throw std::ios_base::failure("Read failed");
+			}
 			array[i] = m_data[m_pos];
 			++m_pos;
 		}
@@ -73,6 +77,9 @@ uint8_t FileStream::getU8() {
 	// Fast Escape Val
 	if (m_nodes > 0 && m_data[m_pos] == OTB::Node::ESCAPE) {
 		++m_pos;
+		if (m_pos >= m_data.size()) {
+			throw std::ios_base::failure("Failed to getU8");
+		}
 	}
 
 	v = m_data[m_pos];
@@ -106,7 +113,7 @@ std::string FileStream::getString() {
 			throw std::ios_base::failure("[FileStream::getString] - Read failed");
 		}
 
-		str = { (char*)&m_data[m_pos], len };
+		str = { reinterpret_cast<const char*>(m_data.data() + m_pos), len };
 		m_pos += len;
 	} else if (len != 0) {
 		throw std::ios_base::failure("[FileStream::getString] - Read failed because string is too big");
@@ -153,3 +160,29 @@ bool FileStream::endNode() {
 	back();
 	return false;
 }
+
+void FileStream::skipNode() {
+	uint32_t depth = 1;
+	while (m_pos < m_data.size()) {
+		const uint8_t value = m_data[m_pos++];
+		if (value == OTB::Node::ESCAPE) {
+			++m_pos;
+		} else if (value == OTB::Node::START) {
+			++depth;
+		} else if (value == OTB::Node::END && --depth == 0) {
+			--m_nodes;
+			return;
+		}
+	}
+
+	throw std::ios_base::failure("[FileStream::skipNode] - Node has no end");
+}
+
+FileStream FileStream::slice(uint32_t begin, uint32_t end) const {
+	if (begin > end || end > m_data.size()) {
+		throw std::ios_base::failure("[FileStream::slice] - Invalid range");
+	}
+
+	const auto data = reinterpret_cast<const char*>(m_data.data());
+	return FileStream(data + begin, data + end);
+}
@@ -9,15 +9,18 @@
 
 #pragma once
 
+/**
+ * Reads OTB nodes straight from the given memory, usually a mapped file.
+ * Nothing is copied, so the memory must outlive the stream.
+ * Escaped bytes are resolved while reading.
+ */
 class FileStream {
 public:
-	FileStream(const char* begin, const char* end) {
-		m_data.insert(m_data.end(), begin, end);
-	}
+	FileStream(const char* begin, const char* end) :
+		m_data(reinterpret_cast<const uint8_t*>(begin), static_cast<size_t>(end - begin)) { }
 
-	explicit FileStream(mio::mmap_source source) {
-		m_data.insert(m_data.end(), source.begin(), source.end());
-	}
+	explicit FileStream(const mio::mmap_source &source) :
+		FileStream(source.begin(), source.end()) { }
 
 	void back(uint32_t pos = 1);
 	void seek(uint32_t pos);
@@ -27,6 +30,10 @@ public:
 
 	bool startNode(uint8_t type = 0);
 	bool endNode();
+	// Moves past the end of the current node, children included, without decoding it
+	void skipNode();
+	// A stream over [begin, end) of this one, sharing the same memory
+	FileStream slice(uint32_t begin, uint32_t end) const;
 	bool isProp(uint8_t prop, bool toNext = true);
 
 	uint8_t getU8();
@@ -41,5 +48,5 @@ private:
 	uint32_t m_nodes { 0 };
 	uint32_t m_pos { 0 };
 
-	std::vector<uint8_t> m_data;
+	std::span<const uint8_t> m_data;
 };
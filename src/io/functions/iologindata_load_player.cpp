@@ -13,6 +13,62 @@
 #include "io/functions/iologindata_load_player.hpp"
 #include "game/game.hpp"
 
+std::string IOLoginDataLoad::getKillsQuery(uint32_t guid) {
+	return fmt::format("SELECT `player_id`, `time`, `target`, `unavenged` FROM `player_kills` WHERE `player_id` = {}", guid);
+}
+
+std::string IOLoginDataLoad::getGuildQuery(uint32_t guid) {
+	return fmt::format("SELECT `guild_id`, `rank_id`, `nick` FROM `guild_membership` WHERE `player_id` = {}", guid);
+}
+
+std::string IOLoginDataLoad::getStashQuery(uint32_t guid) {
+	return fmt::format("SELECT `item_count`, `item_id`  FROM `player_stash` WHERE `player_id` = {}", guid);
+}
+
+std::string IOLoginDataLoad::getCharmsQuery(uint32_t guid) {
+	return fmt::format("SELECT * FROM `player_charms` WHERE `player_guid` = {}", guid);
+}
+
+std::string IOLoginDataLoad::getInventoryItemsQuery(uint32_t guid) {
+	return fmt::format("SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_items` WHERE `player_id` = {} ORDER BY `sid` DESC", guid);
+}
+
+std::string IOLoginDataLoad::getRewardItemsQuery(uint32_t guid) {
+	return fmt::format("SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_rewards` WHERE `player_id` = {} ORDER BY `pid`, `sid` ASC", guid);
+}
+
+std::string IOLoginDataLoad::getDepotItemsQuery(uint32_t guid) {
+	return fmt::format("SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_depotitems` WHERE `player_id` = {} ORDER BY `sid` DESC", guid);
+}
+
+std::string IOLoginDataLoad::getInboxItemsQuery(uint32_t guid) {
+	return fmt::format("SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_inboxitems` WHERE `player_id` = {} ORDER BY `sid` DESC", guid);
+}
+
+std::string IOLoginDataLoad::getStorageQuery(uint32_t guid) {
+	return fmt::format("SELECT `key`, `value` FROM `player_storage` WHERE `player_id` = {}", guid);
+}
+
+std::string IOLoginDataLoad::getVipQuery(uint32_t accountId) {
+	return fmt::format("SELECT `player_id` FROM `account_viplist` WHERE `account_id` = {}", accountId);
+}
+
+std::string IOLoginDataLoad::getPreyQuery(uint32_t guid) {
+	return fmt::format("SELECT * FROM `player_prey` WHERE `player_id` = {}", guid);
+}
+
+std::string IOLoginDataLoad::getTaskHuntingQuery(uint32_t guid) {
+	return fmt::format("SELECT * FROM `player_taskhunt` WHERE `player_id` = {}", guid);
+}
+
+std::string IOLoginDataLoad::getForgeHistoryQuery(uint32_t guid) {
+	return fmt::format("SELECT * FROM `forge_history` WHERE `player_id` = {}", guid);
+}
+
+std::string IOLoginDataLoad::getBosstiaryQuery(uint32_t guid) {
+	return fmt::format("SELECT * FROM `player_bosstiary` WHERE `player_id` = {}", guid);
+}
+
 bool IOLoginDataLoad::preLoadPlayer(Player* player, const std::string &name) {
 	Database &db = Database::getInstance();
 
@@ -305,9 +361,7 @@ void IOLoginDataLoad::loadPlayerKills(Player* player, DBResult_ptr result) {
 	}
 
 	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT `player_id`, `time`, `target`, `unavenged` FROM `player_kills` WHERE `player_id` = " << player->getGUID();
-	if ((result = db.storeQuery(query.str()))) {
+	if ((result = db.storeQuery(getKillsQuery(player->getGUID())))) {
 		do {
 			time_t killTime = result->getNumber<time_t>("time");
 			if ((time(nullptr) - killTime) <= g_configManager().getNumber(FRAG_TIME)) {
@@ -325,8 +379,7 @@ void IOLoginDataLoad::loadPlayerGuild(Player* player, DBResult_ptr result) {
 
 	Database &db = Database::getInstance();
 	std::ostringstream query;
-	query << "SELECT `guild_id`, `rank_id`, `nick` FROM `guild_membership` WHERE `player_id` = " << player->getGUID();
-	if ((result = db.storeQuery(query.str()))) {
+	if ((result = db.storeQuery(getGuildQuery(player->getGUID())))) {
 		uint32_t guildId = result->getNumber<uint32_t>("guild_id");
 		uint32_t playerRankId = result->getNumber<uint32_t>("rank_id");
 		player->guildNick = result->getString("nick");
@@ -374,9 +427,7 @@ void IOLoginDataLoad::loadPlayerStashItems(Player* player, DBResult_ptr result)
 	}
 
 	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT `item_count`, `item_id`  FROM `player_stash` WHERE `player_id` = " << player->getGUID();
-	if ((result = db.storeQuery(query.str()))) {
+	if ((result = db.storeQuery(getStashQuery(player->getGUID())))) {
 		do {
 			player->addItemOnStash(result->getNumber<uint16_t>("item_id"), result->getNumber<uint32_t>("item_count"));
 		} while (result->next());
@@ -391,8 +442,7 @@ void IOLoginDataLoad::loadPlayerBestiaryCharms(Player* player, DBResult_ptr resu
 
 	Database &db = Database::getInstance();
 	std::ostringstream query;
-	query << "SELECT * FROM `player_charms` WHERE `player_guid` = " << player->getGUID();
-	if ((result = db.storeQuery(query.str()))) {
+	if ((result = db.storeQuery(getCharmsQuery(player->getGUID())))) {
 		player->charmPoints = result->getNumber<uint32_t>("charm_points");
 		player->charmExpansion = result->getNumber<bool>("charm_expansion");
 		player->charmRuneWound = result->getNumber<uint16_t>("rune_wound");
@@ -460,14 +510,13 @@ void IOLoginDataLoad::loadPlayerInventoryItems(Player* player, DBResult_ptr resu
 
 	bool oldProtocol = g_configManager().getBoolean(OLD_PROTOCOL) && player->getProtocolVersion() < 1200;
 	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_items` WHERE `player_id` = " << player->getGUID() << " ORDER BY `sid` DESC";
+	const std::string query = getInventoryItemsQuery(player->getGUID());
 
 	InventoryItemsMap inventoryItems;
 	std::vector<std::pair<uint8_t, Container*>> openContainersList;
 
 	try {
-		if ((result = db.storeQuery(query.str()))) {
+		if ((result = db.storeQuery(query))) {
 			loadItems(inventoryItems, result, *player);
 
 			for (InventoryItemsMap::const_reverse_iterator it = inventoryItems.rbegin(), end = inventoryItems.rend(); it != end; ++it) {
@@ -548,11 +597,7 @@ void IOLoginDataLoad::loadRewardItems(Player* player) {
 	}
 
 	RewardItemsMap rewardItems;
-	std::ostringstream query;
-	query.str(std::string());
-	query << "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_rewards` WHERE `player_id` = "
-		  << player->getGUID() << " ORDER BY `pid`, `sid` ASC";
-	if (auto result = Database::getInstance().storeQuery(query.str())) {
+	if (auto result = Database::getInstance().storeQuery(getRewardItemsQuery(player->getGUID()))) {
 		loadItems(rewardItems, result, *player);
 		bindRewardBag(player, rewardItems);
 		insertItemsIntoRewardBag(rewardItems);
@@ -567,9 +612,7 @@ void IOLoginDataLoad::loadPlayerDepotItems(Player* player, DBResult_ptr result)
 
 	Database &db = Database::getInstance();
 	DepotItemsMap depotItems;
-	std::ostringstream query;
-	query << "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_depotitems` WHERE `player_id` = " << player->getGUID() << " ORDER BY `sid` DESC";
-	if ((result = db.storeQuery(query.str()))) {
+	if ((result = db.storeQuery(getDepotItemsQuery(player->getGUID())))) {
 
 		loadItems(depotItems, result, *player);
 		for (DepotItemsMap::const_reverse_iterator it = depotItems.rbegin(), end = depotItems.rend(); it != end; ++it) {
@@ -606,9 +649,7 @@ void IOLoginDataLoad::loadPlayerInboxItems(Player* player, DBResult_ptr result)
 	}
 
 	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT `pid`, `sid`, `itemtype`, `count`, `attributes` FROM `player_inboxitems` WHERE `player_id` = " << player->getGUID() << " ORDER BY `sid` DESC";
-	if ((result = db.storeQuery(query.str()))) {
+	if ((result = db.storeQuery(getInboxItemsQuery(player->getGUID())))) {
 
 		InboxItemsMap inboxItems;
 		loadItems(inboxItems, result, *player);
@@ -643,13 +684,15 @@ void IOLoginDataLoad::loadPlayerStorageMap(Player* player, DBResult_ptr result)
 	}
 
 	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT `key`, `value` FROM `player_storage` WHERE `player_id` = " << player->getGUID();
-	if ((result = db.storeQuery(query.str()))) {
+	if ((result = db.storeQuery(getStorageQuery(player->getGUID())))) {
 		do {
-			player->addStorageValue(result->getNumber<uint32_t>("key"), result->getNumber<int32_t>("value"), true);
+			const auto key = result->getNumber<uint32_t>("key");
+			const auto value = result->getNumber<int32_t>("value");
+			player->saveState.storage[key] = value;
+			player->addStorageValue(key, value, true);
 		} while (result->next());
 	}
+	player->saveState.storageLoaded = true;
 }
 
 void IOLoginDataLoad::loadPlayerVip(Player* player, DBResult_ptr result) {
@@ -659,9 +702,7 @@ void IOLoginDataLoad::loadPlayerVip(Player* player, DBResult_ptr result) {
 	}
 
 	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT `player_id` FROM `account_viplist` WHERE `account_id` = " << player->getAccount();
-	if ((result = db.storeQuery(query.str()))) {
+	if ((result = db.storeQuery(getVipQuery(player->getAccount())))) {
 		do {
 			player->addVIPInternal(result->getNumber<uint32_t>("player_id"));
 		} while (result->next());
@@ -676,9 +717,7 @@ void IOLoginDataLoad::loadPlayerPreyClass(Player* player, DBResult_ptr result) {
 
 	if (g_configManager().getBoolean(PREY_ENABLED)) {
 		Database &db = Database::getInstance();
-		std::ostringstream query;
-		query << "SELECT * FROM `player_prey` WHERE `player_id` = " << player->getGUID();
-		if (result = db.storeQuery(query.str())) {
+		if (result = db.storeQuery(getPreyQuery(player->getGUID()))) {
 			do {
 				auto slot = std::make_unique<PreySlot>(static_cast<PreySlot_t>(result->getNumber<uint16_t>("slot")));
 				auto state = static_cast<PreyDataState_t>(result->getNumber<uint16_t>("state"));
@@ -723,9 +762,7 @@ void IOLoginDataLoad::loadPlayerTaskHuntingClass(Player* player, DBResult_ptr re
 
 	if (g_configManager().getBoolean(TASK_HUNTING_ENABLED)) {
 		Database &db = Database::getInstance();
-		std::ostringstream query;
-		query << "SELECT * FROM `player_taskhunt` WHERE `player_id` = " << player->getGUID();
-		if (result = db.storeQuery(query.str())) {
+		if (result = db.storeQuery(getTaskHuntingQuery(player->getGUID()))) {
 			do {
 				auto slot = std::make_unique<TaskHuntingSlot>(static_cast<PreySlot_t>(result->getNumber<uint16_t>("slot")));
 				auto state = static_cast<PreyTaskDataState_t>(result->getNumber<uint16_t>("state"));
@@ -771,9 +808,7 @@ void IOLoginDataLoad::loadPlayerForgeHistory(Player* player, DBResult_ptr result
 		return;
 	}
 
-	std::ostringstream query;
-	query << "SELECT * FROM `forge_history` WHERE `player_id` = " << player->getGUID();
-	if (result = Database::getInstance().storeQuery(query.str())) {
+	if (result = Database::getInstance().storeQuery(getForgeHistoryQuery(player->getGUID()))) {
 		do {
 			auto actionEnum = magic_enum::enum_value<ForgeConversion_t>(result->getNumber<uint16_t>("action_type"));
 			ForgeHistory history;
@@ -792,9 +827,7 @@ void IOLoginDataLoad::loadPlayerBosstiary(Player* player, DBResult_ptr result) {
 		return;
 	}
 
-	std::ostringstream query;
-	query << "SELECT * FROM `player_bosstiary` WHERE `player_id` = " << player->getGUID();
-	if (result = Database::getInstance().storeQuery(query.str())) {
+	if (result = Database::getInstance().storeQuery(getBosstiaryQuery(player->getGUID()))) {
 		do {
 			player->setSlotBossId(1, result->getNumber<uint16_t>("bossIdSlotOne"));
 			player->setSlotBossId(2, result->getNumber<uint16_t>("bossIdSlotTwo"));
@@ -40,6 +40,22 @@ public:
 	static void loadPlayerInitializeSystem(Player* player);
 	static void loadPlayerUpdateSystem(Player* player);
 
+	// Query text of the loaders reading a table of their own, IOLoginData::prefetchPlayer runs the same queries
+	static std::string getKillsQuery(uint32_t guid);
+	static std::string getGuildQuery(uint32_t guid);
+	static std::string getStashQuery(uint32_t guid);
+	static std::string getCharmsQuery(uint32_t guid);
+	static std::string getInventoryItemsQuery(uint32_t guid);
+	static std::string getRewardItemsQuery(uint32_t guid);
+	static std::string getDepotItemsQuery(uint32_t guid);
+	static std::string getInboxItemsQuery(uint32_t guid);
+	static std::string getStorageQuery(uint32_t guid);
+	static std::string getVipQuery(uint32_t accountId);
+	static std::string getPreyQuery(uint32_t guid);
+	static std::string getTaskHuntingQuery(uint32_t guid);
+	static std::string getForgeHistoryQuery(uint32_t guid);
+	static std::string getBosstiaryQuery(uint32_t guid);
+
 private:
 	using InventoryItemsMap = std::map<uint32_t, std::pair<Item*, uint32_t>>;
 	using RewardItemsMap = std::map<uint32_t, std::pair<Item*, uint32_t>>;
@@ -12,7 +12,63 @@
 #include "io/functions/iologindata_save_player.hpp"
 #include "game/game.hpp"
 
-bool IOLoginDataSave::saveItems(const Player* player, const ItemBlockList &itemList, DBInsert &query_insert, PropWriteStream &propWriteStream) {
+thread_local uint64_t IOLoginDataSave::rowsWritten = 0;
+
+namespace {
+	SaveFingerprint getFingerprint(const std::vector<std::string> &rows) {
+		SaveFingerprint fingerprint;
+		fingerprint.hash = 14695981039346656037ULL;
+		fingerprint.rows = rows.size();
+		fingerprint.valid = true;
+		for (const auto &row : rows) {
+			for (const char c : row) {
+				fingerprint.hash = (fingerprint.hash ^ static_cast<uint8_t>(c)) * 1099511628211ULL;
+			}
+			// Row separator, so moving bytes from one row to the next changes the hash
+			fingerprint.hash = (fingerprint.hash ^ 0xFF) * 1099511628211ULL;
+			fingerprint.check = (fingerprint.check ^ std::hash<std::string> {}(row)) * 0x9E3779B97F4A7C15ULL;
+		}
+		return fingerprint;
+	}
+}
+
+bool IOLoginDataSave::isSectionUnchanged(Player* player, PlayerSaveSection_t section, const std::vector<std::string> &rows) {
+	const auto index = magic_enum::enum_integer(section);
+	const SaveFingerprint fingerprint = getFingerprint(rows);
+	if (player->saveState.sections[index] == fingerprint) {
+		return true;
+	}
+
+	player->saveState.pendingSections[index] = fingerprint;
+	return false;
+}
+
+bool IOLoginDataSave::rewriteSection(Player* player, PlayerSaveSection_t section, std::string_view table, const std::string &insertQuery, const std::vector<std::string> &rows) {
+	if (isSectionUnchanged(player, section, rows)) {
+		return true;
+	}
+
+	Database &db = Database::getInstance();
+	if (!db.executeQuery(fmt::format("DELETE FROM `{}` WHERE `player_id` = {}", table, player->getGUID()))) {
+		g_logger().warn("[IOLoginData::savePlayer] - Error delete query '{}' from player: {}", table, player->getName());
+		return false;
+	}
+
+	DBInsert insert(insertQuery);
+	for (const auto &row : rows) {
+		if (!insert.addRow(row)) {
+			return false;
+		}
+	}
+
+	if (!insert.execute()) {
+		return false;
+	}
+	rowsWritten += rows.size();
+	return true;
+}
+
+bool IOLoginDataSave::saveItems(const Player* player, const ItemBlockList &itemList, std::vector<std::string> &rows, PropWriteStream &propWriteStream) {
 	if (!player) {
 		g_logger().warn("[IOLoginData::savePlayer] - Player nullptr: {}", __FUNCTION__);
 		return false;
@@ -72,10 +128,8 @@ bool IOLoginDataSave::saveItems(const Player* player, const ItemBlockList &itemL
 
 		// Build query string and add row
 		ss << player->getGUID() << ',' << pid << ',' << runningId << ',' << item->getID() << ',' << item->getSubType() << ',' << db.escapeBlob(attributes, static_cast<uint32_t>(attributesSize));
-		if (!query_insert.addRow(ss)) {
-			g_logger().error("Error adding row to query.");
-			return false;
-		}
+		rows.emplace_back(ss.str());
+		ss.str(std::string());
 	}
 
 	// Loop through containers in queue
@@ -130,18 +184,10 @@ bool IOLoginDataSave::saveItems(const Player* player, const ItemBlockList &itemL
 
 			// Build query string and add row
 			ss << player->getGUID() << ',' << parentId << ',' << runningId << ',' << item->getID() << ',' << item->getSubType() << ',' << db.escapeBlob(attributes, static_cast<uint32_t>(attributesSize));
-			if (!query_insert.addRow(ss)) {
-				g_logger().error("Error adding row to query for container item.");
-				return false;
-			}
+			rows.emplace_back(ss.str());
+			ss.str(std::string());
 		}
 	}
-
-	// Execute query
-	if (!query_insert.execute()) {
-		g_logger().error("Error executing query.");
-		return false;
-	}
 	return true;
 }
 
@@ -157,20 +203,14 @@ bool IOLoginDataSave::savePlayerFirst(Player* player) {
 
 	Database &db = Database::getInstance();
 
+	// Characters with the `save` flag cleared only get their last login written,
+	// the flag is checked by the statements themselves so saving never waits on a read
 	std::ostringstream query;
-	query << "SELECT `save` FROM `players` WHERE `id` = " << player->getGUID();
-	DBResult_ptr result = db.storeQuery(query.str());
-	if (!result) {
-		g_logger().warn("[IOLoginData::savePlayer] - Error for select result query from player: {}", player->getName());
+	query << "UPDATE `players` SET `lastlogin` = " << player->lastLoginSaved << ", `lastip` = " << player->lastIP << " WHERE `id` = " << player->getGUID() << " AND `save` = 0";
+	if (!db.executeQuery(query.str())) {
 		return false;
 	}
 
-	if (result->getNumber<uint16_t>("save") == 0) {
-		query.str("");
-		query << "UPDATE `players` SET `lastlogin` = " << player->lastLoginSaved << ", `lastip` = " << player->lastIP << " WHERE `id` = " << player->getGUID();
-		return db.executeQuery(query.str());
-	}
-
 	// First, an UPDATE query to write the player itself
 	query.str("");
 	query << "UPDATE `players` SET ";
@@ -302,7 +342,7 @@ bool IOLoginDataSave::savePlayerFirst(Player* player) {
 		query << "`blessings" << i << "`"
 			  << " = " << static_cast<uint32_t>(player->getBlessingCount(static_cast<uint8_t>(i))) << ((i == 8) ? " " : ",");
 	}
-	query << " WHERE `id` = " << player->getGUID();
+	query << " WHERE `id` = " << player->getGUID() << " AND `save` <> 0";
 
 	if (!db.executeQuery(query.str())) {
 		return false;
@@ -310,88 +350,47 @@ bool IOLoginDataSave::savePlayerFirst(Player* player) {
 	return true;
 }
 
-bool IOLoginDataSave::savePlayerStash(const Player* player) {
+bool IOLoginDataSave::savePlayerStash(Player* player) {
 	if (!player) {
 		g_logger().warn("[IOLoginData::savePlayer] - Player nullptr: {}", __FUNCTION__);
 		return false;
 	}
 
-	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "DELETE FROM `player_stash` WHERE `player_id` = " << player->getGUID();
-	if (!db.executeQuery(query.str())) {
-		return false;
-	}
-
+	std::vector<std::string> rows;
 	for (const auto &[itemId, itemCount] : player->getStashItems()) {
-		query.str("");
-		query << "INSERT INTO `player_stash` (`player_id`,`item_id`,`item_count`) VALUES (";
-		query << player->getGUID() << ", ";
-		query << itemId << ", ";
-		query << itemCount << ")";
-		if (!db.executeQuery(query.str())) {
-			return false;
-		}
+		rows.emplace_back(fmt::format("{},{},{}", player->getGUID(), itemId, itemCount));
 	}
-	return true;
+	return rewriteSection(player, PlayerSaveSection_t::STASH, "player_stash", "INSERT INTO `player_stash` (`player_id`, `item_id`, `item_count`) VALUES ", rows);
 }
 
-bool IOLoginDataSave::savePlayerSpells(const Player* player) {
+bool IOLoginDataSave::savePlayerSpells(Player* player) {
 	if (!player) {
 		g_logger().warn("[IOLoginData::savePlayer] - Player nullptr: {}", __FUNCTION__);
 		return false;
 	}
 
 	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "DELETE FROM `player_spells` WHERE `player_id` = " << player->getGUID();
-	if (!db.executeQuery(query.str())) {
-		return false;
-	}
-
-	query.str("");
-
-	DBInsert spellsQuery("INSERT INTO `player_spells` (`player_id`, `name` ) VALUES ");
+	std::vector<std::string> rows;
 	for (const std::string &spellName : player->learnedInstantSpellList) {
-		query << player->getGUID() << ',' << db.escapeString(spellName);
-		if (!spellsQuery.addRow(query)) {
-			return false;
-		}
+		rows.emplace_back(fmt::format("{},{}", player->getGUID(), db.escapeString(spellName)));
 	}
-
-	if (!spellsQuery.execute()) {
-		return false;
-	}
-	return true;
+	return rewriteSection(player, PlayerSaveSection_t::SPELLS, "player_spells", "INSERT INTO `player_spells` (`player_id`, `name` ) VALUES ", rows);
 }
 
-bool IOLoginDataSave::savePlayerKills(const Player* player) {
+bool IOLoginDataSave::savePlayerKills(Player* player) {
 	if (!player) {
 		g_logger().warn("[IOLoginData::savePlayer] - Player nullptr: {}", __FUNCTION__);
 		return false;
 	}
 
-	Database &db = Database::getInstance();
 	std::ostringstream query;
-	query << "DELETE FROM `player_kills` WHERE `player_id` = " << player->getGUID();
-	if (!db.executeQuery(query.str())) {
-		return false;
-	}
-
-	query.str("");
-
-	DBInsert killsQuery("INSERT INTO `player_kills` (`player_id`, `target`, `time`, `unavenged`) VALUES");
+	std::vector<std::string> rows;
 	for (const auto &kill : player->unjustifiedKills) {
 		query << player->getGUID() << ',' << kill.target << ',' << kill.time << ',' << kill.unavenged;
-		if (!killsQuery.addRow(query)) {
-			return false;
-		}
-	}
-
-	if (!killsQuery.execute()) {
-		return false;
+		rows.emplace_back(query.str());
+		query.str(std::string());
 	}
-	return true;
+	return rewriteSection(player, PlayerSaveSection_t::KILLS, "player_kills", "INSERT INTO `player_kills` (`player_id`, `target`, `time`, `unavenged`) VALUES", rows);
 }
 
 bool IOLoginDataSave::savePlayerBestiarySystem(const Player* player) {
@@ -444,23 +443,13 @@ bool IOLoginDataSave::savePlayerBestiarySystem(const Player* player) {
 	return true;
 }
 
-bool IOLoginDataSave::savePlayerItem(const Player* player) {
+bool IOLoginDataSave::savePlayerItem(Player* player) {
 	if (!player) {
 		g_logger().warn("[IOLoginData::savePlayer] - Player nullptr: {}", __FUNCTION__);
 		return false;
 	}
 
-	Database &db = Database::getInstance();
 	PropWriteStream propWriteStream;
-	std::ostringstream query;
-	query << "DELETE FROM `player_items` WHERE `player_id` = " << player->getGUID();
-	if (!db.executeQuery(query.str())) {
-		g_logger().warn("[IOLoginData::savePlayer] - Error delete query 'player_items' from player: {}", player->getName());
-		return false;
-	}
-
-	DBInsert itemsQuery("INSERT INTO `player_items` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
-
 	ItemBlockList itemList;
 	for (int32_t slotId = CONST_SLOT_FIRST; slotId <= CONST_SLOT_LAST; ++slotId) {
 		Item* item = player->inventory[slotId];
@@ -469,46 +458,37 @@ bool IOLoginDataSave::savePlayerItem(const Player* player) {
 		}
 	}
 
-	if (!saveItems(player, itemList, itemsQuery, propWriteStream)) {
+	std::vector<std::string> rows;
+	if (!saveItems(player, itemList, rows, propWriteStream)) {
 		g_logger().warn("[IOLoginData::savePlayer] - Failed for save items from player: {}", player->getName());
 		return false;
 	}
-	return true;
+	return rewriteSection(player, PlayerSaveSection_t::INVENTORY, "player_items", "INSERT INTO `player_items` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ", rows);
 }
 
-bool IOLoginDataSave::savePlayerDepotItems(const Player* player) {
+bool IOLoginDataSave::savePlayerDepotItems(Player* player) {
 	if (!player) {
 		g_logger().warn("[IOLoginData::savePlayer] - Player nullptr: {}", __FUNCTION__);
 		return false;
 	}
 
-	Database &db = Database::getInstance();
+	if (player->lastDepotId == -1) {
+		return true;
+	}
+
 	PropWriteStream propWriteStream;
 	ItemDepotList depotList;
-	if (player->lastDepotId != -1) {
-		std::ostringstream query;
-		query << "DELETE FROM `player_depotitems` WHERE `player_id` = " << player->getGUID();
-
-		if (!db.executeQuery(query.str())) {
-			return false;
-		}
-
-		query.str("");
-
-		DBInsert depotQuery("INSERT INTO `player_depotitems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
-
-		for (const auto &[pid, depotChest] : player->depotChests) {
-			for (Item* item : depotChest->getItemList()) {
-				depotList.emplace_back(pid, item);
-			}
+	for (const auto &[pid, depotChest] : player->depotChests) {
+		for (Item* item : depotChest->getItemList()) {
+			depotList.emplace_back(pid, item);
 		}
+	}
 
-		if (!saveItems(player, depotList, depotQuery, propWriteStream)) {
-			return false;
-		}
-		return true;
+	std::vector<std::string> rows;
+	if (!saveItems(player, depotList, rows, propWriteStream)) {
+		return false;
 	}
-	return true;
+	return rewriteSection(player, PlayerSaveSection_t::DEPOT, "player_depotitems", "INSERT INTO `player_depotitems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ", rows);
 }
 
 bool IOLoginDataSave::saveRewardItems(Player* player) {
@@ -517,60 +497,42 @@ bool IOLoginDataSave::saveRewardItems(Player* player) {
 		return false;
 	}
 
-	std::ostringstream query;
-	query << "DELETE FROM `player_rewards` WHERE `player_id` = " << player->getGUID();
-
-	if (!Database::getInstance().executeQuery(query.str())) {
-		return false;
-	}
-
 	std::vector<uint64_t> rewardList;
 	player->getRewardList(rewardList);
 
 	ItemRewardList rewardListItems;
-	if (!rewardList.empty()) {
-		for (const auto &rewardId : rewardList) {
-			auto reward = player->getReward(rewardId, false);
-			if (!reward->empty() && (getTimeMsNow() - rewardId <= 1000 * 60 * 60 * 24 * 7)) {
-				rewardListItems.emplace_back(0, reward);
-			}
+	for (const auto &rewardId : rewardList) {
+		auto reward = player->getReward(rewardId, false);
+		if (!reward->empty() && (getTimeMsNow() - rewardId <= 1000 * 60 * 60 * 24 * 7)) {
+			rewardListItems.emplace_back(0, reward);
 		}
+	}
 
-		DBInsert rewardQuery("INSERT INTO `player_rewards` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
-		PropWriteStream propWriteStream;
-		if (!saveItems(player, rewardListItems, rewardQuery, propWriteStream)) {
-			return false;
-		}
+	std::vector<std::string> rows;
+	PropWriteStream propWriteStream;
+	if (!saveItems(player, rewardListItems, rows, propWriteStream)) {
+		return false;
 	}
-	return true;
+	return rewriteSection(player, PlayerSaveSection_t::REWARDS, "player_rewards", "INSERT INTO `player_rewards` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ", rows);
 }
 
-bool IOLoginDataSave::savePlayerInbox(const Player* player) {
+bool IOLoginDataSave::savePlayerInbox(Player* player) {
 	if (!player) {
 		g_logger().warn("[IOLoginData::savePlayer] - Player nullptr: {}", __FUNCTION__);
 		return false;
 	}
 
-	Database &db = Database::getInstance();
 	PropWriteStream propWriteStream;
 	ItemInboxList inboxList;
-	std::ostringstream query;
-	query << "DELETE FROM `player_inboxitems` WHERE `player_id` = " << player->getGUID();
-	if (!db.executeQuery(query.str())) {
-		return false;
-	}
-
-	query.str("");
-	DBInsert inboxQuery("INSERT INTO `player_inboxitems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ");
-
 	for (Item* item : player->getInbox()->getItemList()) {
 		inboxList.emplace_back(0, item);
 	}
 
-	if (!saveItems(player, inboxList, inboxQuery, propWriteStream)) {
+	std::vector<std::string> rows;
+	if (!saveItems(player, inboxList, rows, propWriteStream)) {
 		return false;
 	}
-	return true;
+	return rewriteSection(player, PlayerSaveSection_t::INBOX, "player_inboxitems", "INSERT INTO `player_inboxitems` (`player_id`, `pid`, `sid`, `itemtype`, `count`, `attributes`) VALUES ", rows);
 }
 
 bool IOLoginDataSave::savePlayerPreyClass(Player* player) {
@@ -582,6 +544,7 @@ bool IOLoginDataSave::savePlayerPreyClass(Player* player) {
 	Database &db = Database::getInstance();
 	if (g_configManager().getBoolean(PREY_ENABLED)) {
 		std::ostringstream query;
+		std::vector<std::string> queries;
 		for (uint8_t slotId = PreySlot_First; slotId <= PreySlot_Last; slotId++) {
 			PreySlot* slot = player->getPreySlotById(static_cast<PreySlot_t>(slotId));
 			if (slot) {
@@ -617,13 +580,21 @@ bool IOLoginDataSave::savePlayerPreyClass(Player* player) {
 					  << "`bonus_time` = VALUES(`bonus_time`), "
 					  << "`free_reroll` = VALUES(`free_reroll`), "
 					  << "`monster_list` = VALUES(`monster_list`)";
+				queries.emplace_back(query.str());
+			}
+		}
 
-				if (!db.executeQuery(query.str())) {
-					g_logger().warn("[IOLoginData::savePlayer] - Error saving prey slot data from player: {}", player->getName());
-					return false;
-				}
+		if (isSectionUnchanged(player, PlayerSaveSection_t::PREY, queries)) {
+			return true;
+		}
+
+		for (const auto &slotQuery : queries) {
+			if (!db.executeQuery(slotQuery)) {
+				g_logger().warn("[IOLoginData::savePlayer] - Error saving prey slot data from player: {}", player->getName());
+				return false;
 			}
 		}
+		rowsWritten += queries.size();
 	}
 	return true;
 }
@@ -637,6 +608,7 @@ bool IOLoginDataSave::savePlayerTaskHuntingClass(Player* player) {
 	Database &db = Database::getInstance();
 	if (g_configManager().getBoolean(TASK_HUNTING_ENABLED)) {
 		std::ostringstream query;
+		std::vector<std::string> queries;
 		for (uint8_t slotId = PreySlot_First; slotId <= PreySlot_Last; slotId++) {
 			TaskHuntingSlot* slot = player->getTaskHuntingSlotById(static_cast<PreySlot_t>(slotId));
 			if (slot) {
@@ -670,13 +642,21 @@ bool IOLoginDataSave::savePlayerTaskHuntingClass(Player* player) {
 					  << "`disabled_time` = VALUES(`disabled_time`), "
 					  << "`free_reroll` = VALUES(`free_reroll`), "
 					  << "`monster_list` = VALUES(`monster_list`)";
+				queries.emplace_back(query.str());
+			}
+		}
 
-				if (!db.executeQuery(query.str())) {
-					g_logger().warn("[IOLoginData::savePlayer] - Error saving task hunting slot data from player: {}", player->getName());
-					return false;
-				}
+		if (isSectionUnchanged(player, PlayerSaveSection_t::TASK_HUNTING, queries)) {
+			return true;
+		}
+
+		for (const auto &slotQuery : queries) {
+			if (!db.executeQuery(slotQuery)) {
+				g_logger().warn("[IOLoginData::savePlayer] - Error saving task hunting slot data from player: {}", player->getName());
+				return false;
 			}
 		}
+		rowsWritten += queries.size();
 	}
 	return true;
 }
@@ -688,13 +668,7 @@ bool IOLoginDataSave::savePlayerForgeHistory(Player* player) {
 	}
 
 	std::ostringstream query;
-	query << "DELETE FROM `forge_history` WHERE `player_id` = " << player->getGUID();
-	if (!Database::getInstance().executeQuery(query.str())) {
-		return false;
-	}
-
-	query.str("");
-	DBInsert insertQuery("INSERT INTO `forge_history` (`player_id`, `action_type`, `description`, `done_at`, `is_success`) VALUES");
+	std::vector<std::string> rows;
 	for (const auto &history : player->getForgeHistory()) {
 		const auto stringDescription = Database::getInstance().escapeString(history.description);
 		auto actionString = magic_enum::enum_integer(history.actionType);
@@ -704,32 +678,18 @@ bool IOLoginDataSave::savePlayerForgeHistory(Player* player) {
 			  << stringDescription << ','
 			  << history.createdAt << ','
 			  << history.success;
-
-		if (!insertQuery.addRow(query)) {
-			return false;
-		}
-	}
-	if (!insertQuery.execute()) {
-		return false;
+		rows.emplace_back(query.str());
+		query.str(std::string());
 	}
-	return true;
+	return rewriteSection(player, PlayerSaveSection_t::FORGE_HISTORY, "forge_history", "INSERT INTO `forge_history` (`player_id`, `action_type`, `description`, `done_at`, `is_success`) VALUES", rows);
 }
 
-bool IOLoginDataSave::savePlayerBosstiary(const Player* player) {
+bool IOLoginDataSave::savePlayerBosstiary(Player* player) {
 	if (!player) {
 		g_logger().warn("[IOLoginData::savePlayer] - Player nullptr: {}", __FUNCTION__);
 		return false;
 	}
 
-	std::ostringstream query;
-	query << "DELETE FROM `player_bosstiary` WHERE `player_id` = " << player->getGUID();
-	if (!Database::getInstance().executeQuery(query.str())) {
-		return false;
-	}
-
-	query.str("");
-	DBInsert insertQuery("INSERT INTO `player_bosstiary` (`player_id`, `bossIdSlotOne`, `bossIdSlotTwo`, `removeTimes`, `tracker`) VALUES");
-
 	// Bosstiary tracker
 	PropWriteStream stream;
 	for (const auto &monsterType : player->getCyclopediaMonsterTrackerSet(true)) {
@@ -742,21 +702,15 @@ bool IOLoginDataSave::savePlayerBosstiary(const Player* player) {
 	size_t size;
 	const char* chars = stream.getStream(size);
 	// Append query informations
+	std::ostringstream query;
 	query << player->getGUID() << ','
 		  << player->getSlotBossId(1) << ','
 		  << player->getSlotBossId(2) << ','
 		  << std::to_string(player->getRemoveTimes()) << ','
 		  << Database::getInstance().escapeBlob(chars, static_cast<uint32_t>(size));
 
-	if (!insertQuery.addRow(query)) {
-		return false;
-	}
-
-	if (!insertQuery.execute()) {
-		return false;
-	}
-
-	return true;
+	const std::vector<std::string> rows { query.str() };
+	return rewriteSection(player, PlayerSaveSection_t::BOSSTIARY, "player_bosstiary", "INSERT INTO `player_bosstiary` (`player_id`, `bossIdSlotOne`, `bossIdSlotTwo`, `removeTimes`, `tracker`) VALUES", rows);
 }
 
 bool IOLoginDataSave::savePlayerStorage(Player* player) {
@@ -766,26 +720,81 @@ bool IOLoginDataSave::savePlayerStorage(Player* player) {
 	}
 
 	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "DELETE FROM `player_storage` WHERE `player_id` = " << player->getGUID();
-	if (!db.executeQuery(query.str())) {
-		return false;
-	}
+	player->genReservedStorageRange();
 
-	query.str("");
+	PlayerSaveState &saveState = player->saveState;
+	if (!saveState.storageLoaded) {
+		// The rows in the database are unknown, replace all of them
+		std::ostringstream query;
+		std::vector<std::string> rows;
+		for (const auto &[key, value] : player->storageMap) {
+			query << player->getGUID() << ',' << key << ',' << value;
+			rows.emplace_back(query.str());
+			query.str(std::string());
+		}
 
-	DBInsert storageQuery("INSERT INTO `player_storage` (`player_id`, `key`, `value`) VALUES ");
-	player->genReservedStorageRange();
+		if (!db.executeQuery(fmt::format("DELETE FROM `player_storage` WHERE `player_id` = {}", player->getGUID()))) {
+			return false;
+		}
+
+		DBInsert storageQuery("INSERT INTO `player_storage` (`player_id`, `key`, `value`) VALUES ");
+		for (const auto &row : rows) {
+			if (!storageQuery.addRow(row)) {
+				return false;
+			}
+		}
+
+		if (!storageQuery.execute()) {
+			return false;
+		}
+		rowsWritten += rows.size();
+		saveState.pendingStorage = player->storageMap;
+		return true;
+	}
 
+	// Only keys added, changed or removed since the last save are written
+	DBInsert storageQuery("INSERT INTO `player_storage` (`player_id`, `key`, `value`) VALUES ");
+	storageQuery.upsert({ "value" });
+	size_t changedKeys = 0;
 	for (const auto &[key, value] : player->storageMap) {
-		query << player->getGUID() << ',' << key << ',' << value;
-		if (!storageQuery.addRow(query)) {
+		auto it = saveState.storage.find(key);
+		if (it != saveState.storage.end() && it->second == value) {
+			continue;
+		}
+
+		if (!storageQuery.addRow(fmt::format("{},{},{}", player->getGUID(), key, value))) {
 			return false;
 		}
+		++changedKeys;
+	}
+
+	std::string removedKeys;
+	size_t removedCount = 0;
+	for (const auto &[key, value] : saveState.storage) {
+		if (player->storageMap.contains(key)) {
+			continue;
+		}
+
+		if (!removedKeys.empty()) {
+			removedKeys.push_back(',');
+		}
+		removedKeys.append(std::to_string(key));
+		++removedCount;
+	}
+
+	if (changedKeys == 0 && removedCount == 0) {
+		return true;
 	}
 
 	if (!storageQuery.execute()) {
 		return false;
 	}
+
+	if (removedCount > 0 && !db.executeQuery(fmt::format("DELETE FROM `player_storage` WHERE `player_id` = {} AND `key` IN ({})", player->getGUID(), removedKeys))) {
+		return false;
+	}
+
+	rowsWritten += changedKeys + removedCount;
+	saveState.pendingStorage = player->storageMap;
 	return true;
 }
@@ -14,25 +14,47 @@
 class IOLoginDataSave : public IOLoginData {
 public:
 	static bool savePlayerFirst(Player* player);
-	static bool savePlayerStash(const Player* player);
-	static bool savePlayerSpells(const Player* player);
-	static bool savePlayerKills(const Player* player);
+	static bool savePlayerStash(Player* player);
+	static bool savePlayerSpells(Player* player);
+	static bool savePlayerKills(Player* player);
 	static bool savePlayerBestiarySystem(const Player* player);
-	static bool savePlayerItem(const Player* player);
-	static bool savePlayerDepotItems(const Player* player);
+	static bool savePlayerItem(Player* player);
+	static bool savePlayerDepotItems(Player* player);
 	static bool saveRewardItems(Player* player);
-	static bool savePlayerInbox(const Player* player);
+	static bool savePlayerInbox(Player* player);
 	static bool savePlayerPreyClass(Player* player);
 	static bool savePlayerTaskHuntingClass(Player* player);
 	static bool savePlayerForgeHistory(Player* player);
-	static bool savePlayerBosstiary(const Player* player);
+	static bool savePlayerBosstiary(Player* player);
 	static bool savePlayerStorage(Player* palyer);
 
+	/**
+	 * Rows written by the saves run on the calling thread since the last reset.
+	 */
+	static uint64_t getRowsWritten() {
+		return rowsWritten;
+	}
+	static void resetRowsWritten() {
+		rowsWritten = 0;
+	}
+
 protected:
 	using ItemBlockList = std::list<std::pair<int32_t, Item*>>;
 	using ItemDepotList = std::list<std::pair<int32_t, Item*>>;
 	using ItemRewardList = std::list<std::pair<int32_t, Item*>>;
 	using ItemInboxList = std::list<std::pair<int32_t, Item*>>;
 
-	static bool saveItems(const Player* player, const ItemBlockList &itemList, DBInsert &query_insert, PropWriteStream &stream);
+	static bool saveItems(const Player* player, const ItemBlockList &itemList, std::vector<std::string> &rows, PropWriteStream &stream);
+
+	/**
+	 * \returns True if rows are the ones the section wrote on the player's last save,
+	 * otherwise remembers them to be committed with the save.
+	 */
+	static bool isSectionUnchanged(Player* player, PlayerSaveSection_t section, const std::vector<std::string> &rows);
+	/**
+	 * Replaces the player's rows of table with rows, unless they did not change since the last save.
+	 */
+	static bool rewriteSection(Player* player, PlayerSaveSection_t section, std::string_view table, const std::string &insertQuery, const std::vector<std::string> &rows);
+
+	static thread_local uint64_t rowsWritten;
 };
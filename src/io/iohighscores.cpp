@@ -0,0 +1,184 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2023 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "pch.hpp"
+
+#include "io/iohighscores.hpp"
+#include "config/configmanager.hpp"
+#include "creatures/players/account/account.hpp"
+#include "creatures/players/vocations/vocation.hpp"
+#include "game/scheduling/dispatcher.hpp"
+#include "game/scheduling/scheduler.hpp"
+#include "lib/thread/thread_pool.hpp"
+
+// Indexed by HighscoreCategories_t
+static constexpr std::array<std::string_view, IOHighscores::CATEGORY_COUNT> categoryColumns = {
+	"experience",
+	"skill_fist",
+	"skill_club",
+	"skill_sword",
+	"skill_axe",
+	"skill_dist",
+	"skill_shielding",
+	"skill_fishing",
+	"maglevel",
+};
+
+IOHighscores::VocationMap IOHighscores::getVocationMap() {
+	VocationMap vocations;
+	for (const auto &[id, vocation] : g_vocations().getVocations()) {
+		vocations[id] = { vocation.getFromVocation(), vocation.getClientId() };
+	}
+	return vocations;
+}
+
+std::shared_ptr<const IOHighscores::Tables> IOHighscores::build(const VocationMap &vocations) {
+	auto newTables = std::make_shared<Tables>();
+	auto &entries = newTables->entries;
+
+	std::string query = "SELECT `id`, `name`, `level`, `vocation`";
+	for (const auto &column : categoryColumns) {
+		query += fmt::format(", `{}`", column);
+	}
+	query += fmt::format(" FROM `players` WHERE `group_id` < {} ORDER BY `id`", static_cast<int>(account::GROUP_TYPE_GAMEMASTER));
+
+	if (DBResult_ptr result = Database::getInstance().storeQuery(query)) {
+		entries.reserve(result->countResults());
+		do {
+			Entry &entry = entries.emplace_back();
+			entry.name = result->getString("name");
+			entry.guid = result->getNumber<uint32_t>("id");
+			entry.level = result->getNumber<uint16_t>("level");
+			entry.vocation = result->getNumber<uint16_t>("vocation");
+			for (uint8_t category = 0; category < CATEGORY_COUNT; ++category) {
+				entry.points[category] = result->getNumber<uint64_t>(std::string(categoryColumns[category]));
+			}
+
+			auto it = vocations.find(entry.vocation);
+			entry.clientVocation = it != vocations.end() ? it->second.clientId : 0;
+		} while (result->next());
+	}
+
+	std::vector<uint32_t> order(entries.size());
+	for (uint8_t category = 0; category < CATEGORY_COUNT; ++category) {
+		std::iota(order.begin(), order.end(), 0);
+		std::stable_sort(order.begin(), order.end(), [&entries, category](uint32_t lhs, uint32_t rhs) {
+			return entries[lhs].points[category] > entries[rhs].points[category];
+		});
+
+		Table &table = newTables->categories[category];
+		table.all.rows.reserve(entries.size());
+		// A known base vocation without players still has its (empty) list, unknown ones fall back to all players
+		for (const auto &[id, vocation] : vocations) {
+			table.byVocation[vocation.baseVocation];
+		}
+
+		// Ties share a rank and the next value takes the following one, ranks count every vocation
+		uint32_t rank = 0;
+		for (size_t i = 0; i < order.size(); ++i) {
+			const Entry &entry = entries[order[i]];
+			if (i == 0 || entry.points[category] != entries[order[i - 1]].points[category]) {
+				++rank;
+			}
+
+			const Row row { order[i], rank };
+			table.all.add(row, entry.guid);
+			if (auto it = vocations.find(entry.vocation); it != vocations.end()) {
+				table.byVocation[it->second.baseVocation].add(row, entry.guid);
+			}
+		}
+	}
+	return newTables;
+}
+
+void IOHighscores::load() {
+	const int64_t start = OTSYS_TIME();
+	install(build(getVocationMap()), OTSYS_TIME() - start);
+	g_logger().info("Loaded highscores of {} players in {} ms", getRankedCount(), lastRefreshDuration);
+	scheduleRefresh();
+}
+
+void IOHighscores::refresh() {
+	if (refreshing) {
+		return;
+	}
+	refreshing = true;
+
+	inject<ThreadPool>().addLoad([vocations = getVocationMap()]() {
+		const int64_t start = OTSYS_TIME();
+		auto newTables = build(vocations);
+		const int64_t duration = OTSYS_TIME() - start;
+		g_dispatcher().addTask([newTables = std::move(newTables), duration]() mutable {
+			auto &highscores = g_ioHighscores();
+			highscores.install(std::move(newTables), duration);
+			highscores.refreshing = false;
+			g_logger().debug("Highscores of {} players refreshed in {} ms", highscores.getRankedCount(), duration);
+			highscores.scheduleRefresh();
+		});
+	});
+}
+
+void IOHighscores::install(std::shared_ptr<const Tables> newTables, int64_t duration) {
+	tables = std::move(newTables);
+	lastRefreshDuration = duration;
+	++refreshCount;
+}
+
+void IOHighscores::scheduleRefresh() {
+	const auto interval = g_configManager().getNumber(HIGHSCORES_REFRESH_INTERVAL);
+	if (interval <= 0) {
+		return;
+	}
+
+	g_scheduler().addEvent(static_cast<uint32_t>(interval) * 1000, []() {
+		g_ioHighscores().refresh();
+	});
+}
+
+IOHighscores::Page IOHighscores::getPage(HighscoreType_t type, uint8_t category, uint32_t vocation, uint32_t playerGuid, uint16_t page, uint8_t entriesPerPage) const {
+	Page result;
+	if (!tables || entriesPerPage == 0) {
+		return result;
+	}
+
+	if (category >= CATEGORY_COUNT) {
+		category = HIGHSCORE_CATEGORY_EXPERIENCE;
+	}
+
+	const Table &table = tables->categories[category];
+	const RankList* rankList = &table.all;
+	if (vocation != ALL_VOCATIONS) {
+		if (auto it = table.byVocation.find(vocation); it != table.byVocation.end()) {
+			rankList = &it->second;
+		}
+	}
+
+	if (type == HIGHSCORE_OURRANK) {
+		auto it = rankList->rowByGuid.find(playerGuid);
+		const uint32_t ourRow = it != rankList->rowByGuid.end() ? it->second : 0;
+		result.page = static_cast<uint16_t>(ourRow / entriesPerPage + 1);
+	} else {
+		result.page = std::max<uint16_t>(page, 1);
+	}
+
+	const size_t rowCount = rankList->rows.size();
+	result.pages = static_cast<uint16_t>((rowCount + entriesPerPage - 1) / entriesPerPage);
+
+	const size_t first = static_cast<size_t>(result.page - 1) * entriesPerPage;
+	const size_t last = std::min<size_t>(first + entriesPerPage, rowCount);
+	if (first < last) {
+		result.characters.reserve(last - first);
+	}
+	for (size_t i = first; i < last; ++i) {
+		const Row &row = rankList->rows[i];
+		const Entry &entry = tables->entries[row.entry];
+		result.characters.emplace_back(entry.name, entry.points[category], entry.guid, row.rank, entry.level, entry.clientVocation);
+	}
+	return result;
+}
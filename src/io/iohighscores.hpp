@@ -0,0 +1,123 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2023 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include "database/database.hpp"
+#include "declarations.hpp"
+
+/**
+ * Highscore rank tables kept in memory, one per category and base vocation.
+ * They are rebuilt from the players table on the thread pool every
+ * highscoresRefreshInterval seconds and swapped in on the game thread,
+ * so highscore pages never wait for the database.
+ */
+class IOHighscores {
+public:
+	static constexpr uint8_t CATEGORY_COUNT = HIGHSCORE_CATEGORY_MAGIC_LEVEL + 1;
+	static constexpr uint32_t ALL_VOCATIONS = 0xFFFFFFFF;
+
+	struct Page {
+		std::vector<HighscoreCharacter> characters;
+		uint16_t page = 1;
+		uint16_t pages = 0;
+	};
+
+	IOHighscores() = default;
+
+	// Ensures that we don't accidentally copy it
+	IOHighscores(const IOHighscores &) = delete;
+	IOHighscores &operator=(const IOHighscores &) = delete;
+
+	static IOHighscores &getInstance() {
+		return inject<IOHighscores>();
+	}
+
+	/**
+	 * Builds the tables on the calling thread and schedules the periodic refresh, used on startup.
+	 */
+	void load();
+	/**
+	 * Rebuilds the tables on the thread pool, the current ones keep answering until the new ones are ready.
+	 */
+	void refresh();
+
+	/**
+	 * \returns The page of the given category and vocation, or the page holding
+	 * playerGuid for HIGHSCORE_OURRANK. No characters if there is nothing to show.
+	 */
+	Page getPage(HighscoreType_t type, uint8_t category, uint32_t vocation, uint32_t playerGuid, uint16_t page, uint8_t entriesPerPage) const;
+
+	int64_t getLastRefreshDuration() const {
+		return lastRefreshDuration;
+	}
+	uint64_t getRefreshCount() const {
+		return refreshCount;
+	}
+	size_t getRankedCount() const {
+		return tables ? tables->entries.size() : 0;
+	}
+
+private:
+	struct Entry {
+		std::string name;
+		uint32_t guid = 0;
+		uint16_t level = 0;
+		uint16_t vocation = 0;
+		uint8_t clientVocation = 0;
+		std::array<uint64_t, CATEGORY_COUNT> points {};
+	};
+
+	struct Row {
+		uint32_t entry;
+		uint32_t rank;
+	};
+
+	struct RankList {
+		std::vector<Row> rows;
+		// Player guid -> index in rows, for HIGHSCORE_OURRANK
+		phmap::flat_hash_map<uint32_t, uint32_t> rowByGuid;
+
+		void add(const Row &row, uint32_t guid) {
+			rowByGuid.emplace(guid, static_cast<uint32_t>(rows.size()));
+			rows.push_back(row);
+		}
+	};
+
+	struct Table {
+		RankList all;
+		// Base vocation -> players whose vocation promotes from it
+		phmap::flat_hash_map<uint32_t, RankList> byVocation;
+	};
+
+	struct Tables {
+		std::vector<Entry> entries;
+		std::array<Table, CATEGORY_COUNT> categories;
+	};
+
+	struct VocationInfo {
+		uint32_t baseVocation;
+		uint8_t clientId;
+	};
+	using VocationMap = phmap::flat_hash_map<uint16_t, VocationInfo>;
+
+	// Copied on the game thread, the thread pool must not read the vocations while they can be reloaded
+	static VocationMap getVocationMap();
+	static std::shared_ptr<const Tables> build(const VocationMap &vocations);
+	void install(std::shared_ptr<const Tables> newTables, int64_t duration);
+	void scheduleRefresh();
+
+	// Game thread only
+	std::shared_ptr<const Tables> tables;
+	bool refreshing = false;
+	int64_t lastRefreshDuration = 0;
+	uint64_t refreshCount = 0;
+};
+
+constexpr auto g_ioHighscores = IOHighscores::getInstance;
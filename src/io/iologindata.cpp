@@ -13,6 +13,7 @@
 #include "io/functions/iologindata_load_player.hpp"
 #include "io/functions/iologindata_save_player.hpp"
 #include "game/game.hpp"
+#include "game/scheduling/save_manager.hpp"
 #include "creatures/monsters/monster.hpp"
 #include "creatures/players/wheel/player_wheel.hpp"
 #include "io/ioprey.hpp"
@@ -121,11 +122,12 @@ void IOLoginData::updateOnlineStatus(uint32_t guid, bool login) {
 }
 
 // The boolean "disable" will desactivate the loading of information that is not relevant to the preload, for example, forge, bosstiary, etc. None of this we need to access if the player is offline
+std::string IOLoginData::getPlayerByIdQuery(uint32_t id) {
+	return fmt::format("SELECT * FROM `players` WHERE `id` = {}", id);
+}
+
 bool IOLoginData::loadPlayerById(Player* player, uint32_t id, bool disable /* = true*/) {
-	Database &db = Database::getInstance();
-	std::ostringstream query;
-	query << "SELECT * FROM `players` WHERE `id` = " << id;
-	return loadPlayer(player, db.storeQuery(query.str()), disable);
+	return loadPlayer(player, Database::getInstance().storeQuery(getPlayerByIdQuery(id)), disable);
 }
 
 bool IOLoginData::loadPlayerByName(Player* player, const std::string &name, bool disable /* = true*/) {
@@ -135,6 +137,37 @@ bool IOLoginData::loadPlayerByName(Player* player, const std::string &name, bool
 	return loadPlayer(player, db.storeQuery(query.str()), disable);
 }
 
+void IOLoginData::prefetchPlayer(DBPrefetchedResults &results, uint32_t guid, uint32_t accountId) {
+	// Built by the same functions the loaders use, so the loaders find them by their text
+	std::vector<std::string> queries = {
+		getPlayerByIdQuery(guid),
+		IOLoginDataLoad::getKillsQuery(guid),
+		IOLoginDataLoad::getGuildQuery(guid),
+		IOLoginDataLoad::getStashQuery(guid),
+		IOLoginDataLoad::getCharmsQuery(guid),
+		IOLoginDataLoad::getInventoryItemsQuery(guid),
+		IOLoginDataLoad::getDepotItemsQuery(guid),
+		IOLoginDataLoad::getRewardItemsQuery(guid),
+		IOLoginDataLoad::getInboxItemsQuery(guid),
+		IOLoginDataLoad::getStorageQuery(guid),
+		IOLoginDataLoad::getVipQuery(accountId),
+		IOLoginDataLoad::getForgeHistoryQuery(guid),
+		IOLoginDataLoad::getBosstiaryQuery(guid)
+	};
+
+	if (g_configManager().getBoolean(PREY_ENABLED)) {
+		queries.emplace_back(IOLoginDataLoad::getPreyQuery(guid));
+	}
+	if (g_configManager().getBoolean(TASK_HUNTING_ENABLED)) {
+		queries.emplace_back(IOLoginDataLoad::getTaskHuntingQuery(guid));
+	}
+
+	Database &db = Database::getInstance();
+	for (const auto &query : queries) {
+		results.store(query, db.storeQuery(query));
+	}
+}
+
 bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result, bool disable /* = false*/) {
 	if (!result || !player) {
 		g_logger().warn("[IOLoginData::loadPlayer] - Player or Resultnullptr: {}", __FUNCTION__);
@@ -222,15 +255,44 @@ bool IOLoginData::loadPlayer(Player* player, DBResult_ptr result, bool disable /
 }
 
 bool IOLoginData::savePlayer(Player* player) {
+	if (player) {
+		// A background save of this player that was not written yet must not land after this one
+		g_saveManager().flushPlayer(player);
+	}
+
+	IOLoginDataSave::resetRowsWritten();
 	bool success = DBTransaction::executeWithinTransaction([player]() {
 		return savePlayerGuard(player);
 	});
 
 	if (!success) {
+		if (player) {
+			// Nothing of this save reached the database, the next one must write it all again
+			player->saveState.discard();
+		}
 		g_logger().error("[{}] Error occurred saving player", __FUNCTION__);
+		return false;
 	}
 
-	return success;
+	player->saveState.commit();
+	g_logger().debug("[{}] Saved player {}, {} rows written", __FUNCTION__, player->getName(), IOLoginDataSave::getRowsWritten());
+	return true;
+}
+
+bool IOLoginData::snapshotPlayer(Player* player, DBStatementBatch &batch) {
+	IOLoginDataSave::resetRowsWritten();
+	try {
+		DBRecordScope recordScope(batch);
+		if (!savePlayerGuard(player)) {
+			player->saveState.discard();
+			return false;
+		}
+		return true;
+	} catch (const std::exception &e) {
+		player->saveState.discard();
+		g_logger().warn("[{}] Error while recording player save: {}", __FUNCTION__, e.what());
+		return false;
+	}
 }
 
 bool IOLoginData::savePlayerGuard(Player* player) {
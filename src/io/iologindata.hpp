@@ -26,7 +26,19 @@ public:
 	static bool loadPlayerById(Player* player, uint32_t id, bool disable = true);
 	static bool loadPlayerByName(Player* player, const std::string &name, bool disable = true);
 	static bool loadPlayer(Player* player, DBResult_ptr result, bool disable = true);
+	/**
+	 * Runs the queries loadPlayerById would issue for this character and keeps
+	 * their results, so the player can later be loaded without waiting on the
+	 * database. Safe to call outside the dispatcher thread.
+	 */
+	static void prefetchPlayer(DBPrefetchedResults &results, uint32_t guid, uint32_t accountId);
+	static std::string getPlayerByIdQuery(uint32_t id);
 	static bool savePlayer(Player* player);
+	/**
+	 * Records the statements savePlayer would run into batch instead of running them.
+	 * The player's save state is only committed once the batch is written.
+	 */
+	static bool snapshotPlayer(Player* player, DBStatementBatch &batch);
 	static uint32_t getGuidByName(const std::string &name);
 	static bool getGuidByNameEx(uint32_t &guid, bool &specialVip, std::string &name);
 	static std::string getNameByGuid(uint32_t guid);
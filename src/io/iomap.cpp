@@ -12,6 +12,7 @@
 #include "game/movement/teleport.hpp"
 #include "game/game.hpp"
 #include "io/filestream.hpp"
+#include "lib/thread/thread_pool.hpp"
 
 /*
 	OTBM_ROOTV1
@@ -111,94 +112,127 @@ void IOMap::parseMapDataAttributes(FileStream &stream, Map* map, const std::stri
 }
 
 void IOMap::parseTileArea(FileStream &stream, Map &map, const Position &pos) {
-	while (stream.startNode(OTBM_TILE_AREA)) {
-		const uint16_t base_x = stream.getU16();
-		const uint16_t base_y = stream.getU16();
-		const uint8_t base_z = stream.getU8();
+	const int64_t start = OTSYS_TIME();
 
-		bool tileIsStatic = false;
+	// Tile areas don't depend on each other, only find their bounds here and decode them in parallel
+	std::vector<std::pair<uint32_t, uint32_t>> areas;
+	for (uint32_t areaStart = stream.tell(); stream.startNode(OTBM_TILE_AREA); areaStart = stream.tell()) {
+		stream.skipNode();
+		areas.emplace_back(areaStart, stream.tell());
+	}
 
-		while (stream.startNode()) {
-			uint8_t tileType = stream.getU8();
-			if (tileType != OTBM_HOUSETILE && tileType != OTBM_TILE)
-				throw IOMapException("Could not read tile type node.");
+	if (areas.empty()) {
+		return;
+	}
 
-			const auto &tile = std::make_shared<BasicTile>();
+	const int64_t splitTime = OTSYS_TIME();
+
+	// A few chunks per thread, so a chunk full of dense areas doesn't hold up the others
+	const size_t chunkCount = std::min<size_t>(areas.size(), std::max<size_t>(getNumberOfCores(), 1) * 4);
+	struct Chunk {
+		std::vector<DecodedTile> tiles;
+		std::exception_ptr error;
+	};
+	std::vector<Chunk> chunks(chunkCount);
+	std::latch pending(static_cast<std::ptrdiff_t>(chunkCount));
+
+	for (size_t i = 0; i < chunkCount; ++i) {
+		const size_t first = areas.size() * i / chunkCount;
+		const size_t last = areas.size() * (i + 1) / chunkCount;
+		inject<ThreadPool>().addLoad([&, first, last, i] {
+			Chunk &chunk = chunks[i];
+			try {
+				for (size_t area = first; area < last; ++area) {
+					FileStream areaStream = stream.slice(areas[area].first, areas[area].second);
+					decodeTileArea(areaStream, map, pos, chunk.tiles);
+				}
+			} catch (...) {
+				chunk.error = std::current_exception();
+			}
+			pending.count_down();
+		});
+	}
 
-			const uint8_t tileCoordsX = stream.getU8();
-			const uint8_t tileCoordsY = stream.getU8();
+	pending.wait();
 
-			const uint16_t x = base_x + tileCoordsX + pos.x;
-			const uint16_t y = base_y + tileCoordsY + pos.y;
-			const uint8_t z = static_cast<uint8_t>(base_z + pos.z);
+	const int64_t decodeTime = OTSYS_TIME();
 
-			if (tileType == OTBM_HOUSETILE) {
-				tile->houseId = stream.getU32();
-				if (!map.houses.addHouse(tile->houseId))
-					throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Could not create house id: {}", x, y, z, tile->houseId));
+	// Placed in file order, so a tile that shows up twice still ends up as the last one read
+	size_t tileCount = 0;
+	for (const Chunk &chunk : chunks) {
+		if (chunk.error) {
+			std::rethrow_exception(chunk.error);
+		}
+
+		for (const auto &[x, y, z, tile] : chunk.tiles) {
+			if (tile->isHouse() && !map.houses.addHouse(tile->houseId)) {
+				throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Could not create house id: {}", x, y, z, tile->houseId));
 			}
 
-			if (stream.isProp(OTBM_ATTR_TILE_FLAGS)) {
-				const uint32_t flags = stream.getU32();
-				if ((flags & OTBM_TILEFLAG_PROTECTIONZONE) != 0) {
-					tile->flags |= TILESTATE_PROTECTIONZONE;
-				} else if ((flags & OTBM_TILEFLAG_NOPVPZONE) != 0) {
-					tile->flags |= TILESTATE_NOPVPZONE;
-				} else if ((flags & OTBM_TILEFLAG_PVPZONE) != 0) {
-					tile->flags |= TILESTATE_PVPZONE;
-				}
+			map.setBasicTile(x, y, z, tile);
+		}
+		tileCount += chunk.tiles.size();
+	}
 
-				if ((flags & OTBM_TILEFLAG_NOLOGOUT) != 0) {
-					tile->flags |= TILESTATE_NOLOGOUT;
-				}
-			}
+	g_logger().info("Map tile areas: {} tiles in {} areas, split {} ms, decoded in {} chunks {} ms, placed {} ms", tileCount, areas.size(), splitTime - start, chunkCount, decodeTime - splitTime, OTSYS_TIME() - decodeTime);
+}
 
-			if (stream.isProp(OTBM_ATTR_ITEM)) {
-				const uint16_t id = stream.getU16();
-				const ItemType &iType = Item::items[id];
-
-				if (!tile->isHouse() || !iType.isBed()) {
-					if (iType.blockSolid)
-						tileIsStatic = true;
-
-					const auto &item = std::make_shared<BasicItem>();
-					item->id = id;
-
-					if (tile->isHouse() && iType.moveable) {
-						g_logger().warn("[IOMap::loadMap] - "
-										"Moveable item with ID: {}, in house: {}, "
-										"at position: x {}, y {}, z {}",
-										id, tile->houseId, x, y, z);
-					} else if (iType.isGroundTile()) {
-						tile->ground = map.tryReplaceItemFromCache(item);
-					} else {
-						tile->items.emplace_back(map.tryReplaceItemFromCache(item));
-					}
-				}
-			}
+void IOMap::decodeTileArea(FileStream &stream, Map &map, const Position &pos, std::vector<DecodedTile> &decodedTiles) {
+	if (!stream.startNode(OTBM_TILE_AREA)) {
+		throw IOMapException("Could not read tile area node.");
+	}
 
-			while (stream.startNode()) {
-				if (stream.getU8() != OTBM_ITEM) {
-					throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Could not read item node.", x, y, z));
-				}
+	const uint16_t base_x = stream.getU16();
+	const uint16_t base_y = stream.getU16();
+	const uint8_t base_z = stream.getU8();
 
-				const uint16_t id = stream.getU16();
+	bool tileIsStatic = false;
 
-				const auto &iType = Item::items[id];
+	while (stream.startNode()) {
+		uint8_t tileType = stream.getU8();
+		if (tileType != OTBM_HOUSETILE && tileType != OTBM_TILE)
+			throw IOMapException("Could not read tile type node.");
 
-				if (iType.blockSolid) {
+		const auto &tile = std::make_shared<BasicTile>();
+
+		const uint8_t tileCoordsX = stream.getU8();
+		const uint8_t tileCoordsY = stream.getU8();
+
+		const uint16_t x = base_x + tileCoordsX + pos.x;
+		const uint16_t y = base_y + tileCoordsY + pos.y;
+		const uint8_t z = static_cast<uint8_t>(base_z + pos.z);
+
+		if (tileType == OTBM_HOUSETILE) {
+			tile->houseId = stream.getU32();
+		}
+
+		if (stream.isProp(OTBM_ATTR_TILE_FLAGS)) {
+			const uint32_t flags = stream.getU32();
+			if ((flags & OTBM_TILEFLAG_PROTECTIONZONE) != 0) {
+				tile->flags |= TILESTATE_PROTECTIONZONE;
+			} else if ((flags & OTBM_TILEFLAG_NOPVPZONE) != 0) {
+				tile->flags |= TILESTATE_NOPVPZONE;
+			} else if ((flags & OTBM_TILEFLAG_PVPZONE) != 0) {
+				tile->flags |= TILESTATE_PVPZONE;
+			}
+
+			if ((flags & OTBM_TILEFLAG_NOLOGOUT) != 0) {
+				tile->flags |= TILESTATE_NOLOGOUT;
+			}
+		}
+
+		if (stream.isProp(OTBM_ATTR_ITEM)) {
+			const uint16_t id = stream.getU16();
+			const ItemType &iType = Item::items[id];
+
+			if (!tile->isHouse() || !iType.isBed()) {
+				if (iType.blockSolid)
 					tileIsStatic = true;
-				}
 
 				const auto &item = std::make_shared<BasicItem>();
 				item->id = id;
 
-				if (!item->unserializeItemNode(stream, x, y, z))
-					throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Failed to load item {}, Node Type.", x, y, z, id));
-
-				if (tile->isHouse() && iType.isBed()) {
-					// nothing
-				} else if (tile->isHouse() && iType.moveable) {
+				if (tile->isHouse() && iType.moveable) {
 					g_logger().warn("[IOMap::loadMap] - "
 									"Moveable item with ID: {}, in house: {}, "
 									"at position: x {}, y {}, z {}",
@@ -208,22 +242,55 @@ void IOMap::parseTileArea(FileStream &stream, Map &map, const Position &pos) {
 				} else {
 					tile->items.emplace_back(map.tryReplaceItemFromCache(item));
 				}
+			}
+		}
 
-				if (!stream.endNode()) {
-					throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Could not end node.", x, y, z));
-				}
+		while (stream.startNode()) {
+			if (stream.getU8() != OTBM_ITEM) {
+				throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Could not read item node.", x, y, z));
+			}
+
+			const uint16_t id = stream.getU16();
+
+			const auto &iType = Item::items[id];
+
+			if (iType.blockSolid) {
+				tileIsStatic = true;
+			}
+
+			const auto &item = std::make_shared<BasicItem>();
+			item->id = id;
+
+			if (!item->unserializeItemNode(stream, x, y, z))
+				throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Failed to load item {}, Node Type.", x, y, z, id));
+
+			if (tile->isHouse() && iType.isBed()) {
+				// nothing
+			} else if (tile->isHouse() && iType.moveable) {
+				g_logger().warn("[IOMap::loadMap] - "
+								"Moveable item with ID: {}, in house: {}, "
+								"at position: x {}, y {}, z {}",
+								id, tile->houseId, x, y, z);
+			} else if (iType.isGroundTile()) {
+				tile->ground = map.tryReplaceItemFromCache(item);
+			} else {
+				tile->items.emplace_back(map.tryReplaceItemFromCache(item));
 			}
 
 			if (!stream.endNode()) {
 				throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Could not end node.", x, y, z));
 			}
-
-			map.setBasicTile(x, y, z, tile);
 		}
 
 		if (!stream.endNode()) {
-			throw IOMapException("Could not end node.");
+			throw IOMapException(fmt::format("[x:{}, y:{}, z:{}] Could not end node.", x, y, z));
 		}
+
+		decodedTiles.push_back({ x, y, z, map.tryReplaceTileFromCache(tile) });
+	}
+
+	if (!stream.endNode()) {
+		throw IOMapException("Could not end node.");
 	}
 }
 
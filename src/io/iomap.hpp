@@ -134,4 +134,14 @@ private:
 	static void parseWaypoints(FileStream &stream, Map &map);
 	static void parseTowns(FileStream &stream, Map &map);
 	static void parseTileArea(FileStream &stream, Map &map, const Position &pos);
+
+	struct DecodedTile {
+		uint16_t x;
+		uint16_t y;
+		uint8_t z;
+		BasicTilePtr tile;
+	};
+
+	// Decodes a single tile area node, may run on any thread
+	static void decodeTileArea(FileStream &stream, Map &map, const Position &pos, std::vector<DecodedTile> &decodedTiles);
 };
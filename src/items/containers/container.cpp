@@ -35,6 +35,7 @@ Container::Container(Tile* tile) :
 			if (((item->getContainer() || item->hasProperty(CONST_PROP_MOVEABLE)) || (item->isWrapable() && !item->hasProperty(CONST_PROP_MOVEABLE) && !item->hasProperty(CONST_PROP_BLOCKPATH))) && !item->hasAttribute(ItemAttribute_t::UNIQUEID)) {
 				itemlist.push_front(item);
 				item->setParent(this);
+				addContentItemCounts(item);
 			}
 		}
 	}
@@ -63,6 +64,7 @@ Item* Container::clone() const {
 		clone->addItem(item->clone());
 	}
 	clone->totalWeight = totalWeight;
+	clone->contentItemCounts = contentItemCounts;
 	return clone;
 }
 
@@ -167,6 +169,7 @@ bool Container::unserializeItemNode(OTB::Loader &loader, const OTB::Node &node,
 
 		addItem(item);
 		updateItemWeight(item->getWeight());
+		addContentItemCounts(item);
 	}
 	return true;
 }
@@ -191,6 +194,39 @@ void Container::updateItemWeight(int32_t diff) {
 	}
 }
 
+void Container::updateContentItemCount(uint16_t itemId, int32_t diff) {
+	if (diff == 0) {
+		return;
+	}
+
+	Container* container = this;
+	do {
+		auto &count = container->contentItemCounts[itemId];
+		count += diff;
+		if (count == 0) {
+			container->contentItemCounts.erase(itemId);
+		}
+	} while ((container = container->getParentContainer()) != nullptr);
+}
+
+void Container::addContentItemCounts(const Item* item) {
+	updateContentItemCount(item->getID(), item->getItemCount());
+	if (const Container* container = item->getContainer()) {
+		for (const auto &[itemId, count] : container->contentItemCounts) {
+			updateContentItemCount(itemId, static_cast<int32_t>(count));
+		}
+	}
+}
+
+void Container::removeContentItemCounts(const Item* item) {
+	updateContentItemCount(item->getID(), -static_cast<int32_t>(item->getItemCount()));
+	if (const Container* container = item->getContainer()) {
+		for (const auto &[itemId, count] : container->contentItemCounts) {
+			updateContentItemCount(itemId, -static_cast<int32_t>(count));
+		}
+	}
+}
+
 uint32_t Container::getWeight() const {
 	return Item::getWeight() + totalWeight;
 }
@@ -571,6 +607,7 @@ void Container::addThing(int32_t index, Thing* thing) {
 	item->setParent(this);
 	itemlist.push_front(item);
 	updateItemWeight(item->getWeight());
+	addContentItemCounts(item);
 
 	// send change to client
 	if (getParent() && (getParent() != VirtualCylinder::virtualCylinder)) {
@@ -581,6 +618,7 @@ void Container::addThing(int32_t index, Thing* thing) {
 void Container::addItemBack(Item* item) {
 	addItem(item);
 	updateItemWeight(item->getWeight());
+	addContentItemCounts(item);
 
 	// send change to client
 	if (getParent() && (getParent() != VirtualCylinder::virtualCylinder)) {
@@ -600,9 +638,11 @@ void Container::updateThing(Thing* thing, uint16_t itemId, uint32_t count) {
 	}
 
 	const int32_t oldWeight = item->getWeight();
+	updateContentItemCount(item->getID(), -static_cast<int32_t>(item->getItemCount()));
 	item->setID(itemId);
 	item->setSubType(count);
 	updateItemWeight(-oldWeight + item->getWeight());
+	updateContentItemCount(item->getID(), item->getItemCount());
 
 	// send change to client
 	if (getParent()) {
@@ -624,6 +664,8 @@ void Container::replaceThing(uint32_t index, Thing* thing) {
 	itemlist[index] = item;
 	item->setParent(this);
 	updateItemWeight(-static_cast<int32_t>(replacedItem->getWeight()) + item->getWeight());
+	removeContentItemCounts(replacedItem);
+	addContentItemCounts(item);
 
 	// send change to client
 	if (getParent()) {
@@ -647,6 +689,7 @@ void Container::removeThing(Thing* thing, uint32_t count) {
 	if (item->isStackable() && count != item->getItemCount()) {
 		uint8_t newCount = static_cast<uint8_t>(std::max<int32_t>(0, item->getItemCount() - count));
 		const int32_t oldWeight = item->getWeight();
+		updateContentItemCount(item->getID(), static_cast<int32_t>(newCount) - item->getItemCount());
 		item->setItemCount(newCount);
 		updateItemWeight(-oldWeight + item->getWeight());
 
@@ -656,6 +699,7 @@ void Container::removeThing(Thing* thing, uint32_t count) {
 		}
 	} else {
 		updateItemWeight(-static_cast<int32_t>(item->getWeight()));
+		removeContentItemCounts(item);
 
 		// send change to client
 		if (getParent()) {
@@ -765,6 +809,7 @@ void Container::internalAddThing(uint32_t, Thing* thing) {
 	item->setParent(this);
 	itemlist.push_front(item);
 	updateItemWeight(item->getWeight());
+	addContentItemCounts(item);
 }
 
 void Container::startDecaying() {
@@ -820,6 +865,7 @@ void Container::removeItem(Thing* thing, bool sendUpdateToClient /* = false*/) {
 		}
 
 		itemlist.erase(it);
+		removeContentItemCounts(itemToRemove);
 		itemToRemove->setParent(nullptr);
 	}
 }
@@ -153,6 +153,18 @@ public:
 	std::map<uint32_t, uint32_t> &getAllItemTypeCount(std::map<uint32_t, uint32_t> &countMap) const override final;
 	Thing* getThing(size_t index) const override final;
 
+	/**
+	 * Item count of itemId across everything inside this container, nested containers included.
+	 * Kept up to date on every change of the contents, like the weight.
+	 */
+	uint32_t getContentItemCount(uint16_t itemId) const {
+		auto it = contentItemCounts.find(itemId);
+		return it != contentItemCounts.end() ? it->second : 0;
+	}
+	const phmap::flat_hash_map<uint16_t, uint32_t> &getContentItemCounts() const {
+		return contentItemCounts;
+	}
+
 	ItemVector getItems(bool recursive = false) const;
 
 	void postAddNotification(Thing* thing, const Cylinder* oldParent, int32_t index, CylinderLink_t link = LINK_OWNER) override;
@@ -170,6 +182,8 @@ protected:
 
 	uint32_t maxSize;
 	uint32_t totalWeight = 0;
+	// Recursive itemId -> count of the contents, see getContentItemCount
+	phmap::flat_hash_map<uint16_t, uint32_t> contentItemCounts;
 	ItemDeque itemlist;
 	uint32_t serializationCount = 0;
 
@@ -178,6 +192,9 @@ protected:
 
 	friend class MapCache;
 
+	void addContentItemCounts(const Item* item);
+	void removeContentItemCounts(const Item* item);
+
 private:
 	void onAddContainerItem(Item* item);
 	void onUpdateContainerItem(uint32_t index, Item* oldItem, Item* newItem);
@@ -186,6 +203,7 @@ private:
 	Container* getParentContainer();
 	Container* getTopParentContainer() const;
 	void updateItemWeight(int32_t diff);
+	void updateContentItemCount(uint16_t itemId, int32_t diff);
 
 	friend class ContainerIterator;
 	friend class IOMapSerialize;
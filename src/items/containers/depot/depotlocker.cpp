@@ -46,4 +46,5 @@ void DepotLocker::removeInbox(Inbox* inbox) {
 		return;
 	}
 	itemlist.erase(cit);
+	removeContentItemCounts(inbox);
 }
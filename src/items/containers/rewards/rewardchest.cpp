@@ -52,6 +52,7 @@ void RewardChest::removeItem(Thing* thing, bool /* sendToClient = false*/) {
 	auto it = std::ranges::find(itemlist.begin(), itemlist.end(), itemToRemove);
 	if (it != itemlist.end()) {
 		itemlist.erase(it);
+		removeContentItemCounts(itemToRemove);
 		itemToRemove->setParent(nullptr);
 	}
 }
@@ -936,7 +936,7 @@ void Tile::addThing(int32_t, Thing* thing) {
 
 	Creature* creature = thing->getCreature();
 	if (creature) {
-		g_game().map.clearSpectatorCache();
+		g_game().map.clearSpectatorCache(getPosition());
 		creature->setParent(this);
 		CreatureVector* creatures = makeCreatures();
 		creatures->insert(creatures->begin(), creature);
@@ -1138,7 +1138,7 @@ void Tile::removeThing(Thing* thing, uint32_t count) {
 		if (creatures) {
 			auto it = std::find(creatures->begin(), creatures->end(), thing);
 			if (it != creatures->end()) {
-				g_game().map.clearSpectatorCache();
+				g_game().map.clearSpectatorCache(getPosition());
 				creatures->erase(it);
 			}
 		}
@@ -1541,7 +1541,7 @@ void Tile::internalAddThing(uint32_t, Thing* thing) {
 
 	Creature* creature = thing->getCreature();
 	if (creature) {
-		g_game().map.clearSpectatorCache();
+		g_game().map.clearSpectatorCache(getPosition());
 		CreatureVector* creatures = makeCreatures();
 		creatures->insert(creatures->begin(), creature);
 	} else {
@@ -1591,7 +1591,29 @@ void Tile::updateTileFlags(const Item* item) {
 	setTileFlags(item);
 }
 
+uint8_t Tile::getBlocking() const {
+	uint8_t blocking = TILE_BLOCKING_NONE;
+	if (hasFlag(TILESTATE_BLOCKPROJECTILE)) {
+		blocking |= TILE_BLOCKING_PROJECTILE;
+	}
+	if (hasFlag(TILESTATE_BLOCKSOLID)) {
+		blocking |= TILE_BLOCKING_SOLID;
+	}
+	if (!ground || hasFlag(TILESTATE_FLOORCHANGE | TILESTATE_TELEPORT)) {
+		blocking |= TILE_BLOCKING_PATH;
+	}
+	if (hasFlag(TILESTATE_MAGICFIELD)) {
+		blocking |= TILE_BLOCKING_FIELD;
+	}
+	if (hasFlag(TILESTATE_PROTECTIONZONE | TILESTATE_NOFIELDBLOCKPATH)) {
+		blocking |= TILE_BLOCKING_MONSTER_PATH;
+	}
+	return blocking;
+}
+
 void Tile::setTileFlags(const Item* item) {
+	const uint8_t oldBlocking = getBlocking();
+
 	if (!hasFlag(TILESTATE_FLOORCHANGE)) {
 		const ItemType &it = Item::items[item->getID()];
 		if (it.floorChange != 0) {
@@ -1635,6 +1657,10 @@ void Tile::setTileFlags(const Item* item) {
 		setFlag(TILESTATE_BLOCKSOLID);
 	}
 
+	if (item->hasProperty(CONST_PROP_BLOCKPROJECTILE)) {
+		setFlag(TILESTATE_BLOCKPROJECTILE);
+	}
+
 	if (item->getBed()) {
 		setFlag(TILESTATE_BED);
 	}
@@ -1647,9 +1673,16 @@ void Tile::setTileFlags(const Item* item) {
 	if (item->hasProperty(CONST_PROP_SUPPORTHANGABLE)) {
 		setFlag(TILESTATE_SUPPORTS_HANGABLE);
 	}
+
+	// The ground pointer changes before these are called, so a ground always refreshes the bitmaps
+	if (getBlocking() != oldBlocking || item->isGroundTile()) {
+		g_game().map.updateTileBlocking(*this);
+	}
 }
 
 void Tile::resetTileFlags(const Item* item) {
+	const uint8_t oldBlocking = getBlocking();
+
 	const ItemType &it = Item::items[item->getID()];
 	if (it.floorChange != 0) {
 		resetFlag(TILESTATE_FLOORCHANGE);
@@ -1659,6 +1692,10 @@ void Tile::resetTileFlags(const Item* item) {
 		resetFlag(TILESTATE_BLOCKSOLID);
 	}
 
+	if (item->hasProperty(CONST_PROP_BLOCKPROJECTILE) && !hasProperty(item, CONST_PROP_BLOCKPROJECTILE)) {
+		resetFlag(TILESTATE_BLOCKPROJECTILE);
+	}
+
 	if (item->hasProperty(CONST_PROP_IMMOVABLEBLOCKSOLID) && !hasProperty(item, CONST_PROP_IMMOVABLEBLOCKSOLID)) {
 		resetFlag(TILESTATE_IMMOVABLEBLOCKSOLID);
 	}
@@ -1707,6 +1744,10 @@ void Tile::resetTileFlags(const Item* item) {
 	if (item->hasProperty(CONST_PROP_SUPPORTHANGABLE)) {
 		resetFlag(TILESTATE_SUPPORTS_HANGABLE);
 	}
+
+	if (getBlocking() != oldBlocking || item->isGroundTile()) {
+		g_game().map.updateTileBlocking(*this);
+	}
 }
 
 bool Tile::isMoveableBlocking() const {
@@ -1744,6 +1785,6 @@ Item* Tile::getDoorItem() const {
 	return nullptr;
 }
 
-const phmap::parallel_flat_hash_set<std::shared_ptr<Zone>> Tile::getZones() {
+ZoneList Tile::getZones() {
 	return Zone::getZones(getPosition());
 }
@@ -13,6 +13,7 @@
 #include "declarations.hpp"
 #include "items/item.hpp"
 #include "utils/tools.hpp"
+#include "game/zones/zone.hpp"
 
 class Creature;
 class Teleport;
@@ -21,7 +22,6 @@ class Mailbox;
 class MagicField;
 class BedItem;
 class House;
-class Zone;
 
 using CreatureVector = std::vector<Creature*>;
 using ItemVector = std::vector<Item*>;
@@ -173,7 +173,12 @@ public:
 		this->flags &= ~flag;
 	}
 
-	const phmap::parallel_flat_hash_set<std::shared_ptr<Zone>> getZones();
+	/**
+	 * \returns The TileBlocking_t flags the map keeps in the bitmaps of this position's floor.
+	 */
+	uint8_t getBlocking() const;
+
+	ZoneList getZones();
 
 	ZoneType_t getZoneType() const {
 		if (hasFlag(TILESTATE_PROTECTIONZONE)) {
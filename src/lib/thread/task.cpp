@@ -0,0 +1,56 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2022 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "pch.hpp"
+
+#include "lib/thread/task.hpp"
+
+namespace {
+	// Blocks above this count go back to the heap, a consumer thread must not hoard every producer's blocks
+	constexpr size_t MAX_CACHED_BLOCKS = 4096;
+
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+
+	struct ThreadCache {
+		FreeBlock* head = nullptr;
+		size_t size = 0;
+
+		~ThreadCache() {
+			while (head) {
+				::operator delete(std::exchange(head, head->next));
+			}
+		}
+	};
+
+	thread_local ThreadCache threadCache;
+}
+
+std::atomic<uint64_t> TaskPool::heapAllocations { 0 };
+
+void* TaskPool::allocate(size_t size) {
+	if (size <= BLOCK_SIZE && threadCache.head) {
+		--threadCache.size;
+		return std::exchange(threadCache.head, threadCache.head->next);
+	}
+
+	heapAllocations.fetch_add(1, std::memory_order_relaxed);
+	return ::operator new(std::max(size, BLOCK_SIZE));
+}
+
+void TaskPool::deallocate(void* block, size_t size) {
+	if (size > BLOCK_SIZE || threadCache.size >= MAX_CACHED_BLOCKS) {
+		::operator delete(block);
+		return;
+	}
+
+	threadCache.head = ::new (block) FreeBlock { threadCache.head };
+	++threadCache.size;
+}
@@ -0,0 +1,175 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2022 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+/**
+ * Fixed size blocks for task callables that do not fit inline.
+ * Each thread keeps its own freelist, blocks released by another
+ * thread simply join the releasing thread's freelist.
+ */
+class TaskPool {
+public:
+	static constexpr size_t BLOCK_SIZE = 256;
+
+	static void* allocate(size_t size);
+	static void deallocate(void* block, size_t size);
+
+	// Number of times the pool had to fall back to the heap
+	static uint64_t getHeapAllocations() {
+		return heapAllocations.load(std::memory_order_relaxed);
+	}
+
+private:
+	static std::atomic<uint64_t> heapAllocations;
+};
+
+/**
+ * Move-only callable with its scheduling data. Small callables are
+ * stored inside the task itself, bigger ones in a pooled block, so
+ * creating and running a task does not touch the heap in the common case.
+ */
+class Task {
+public:
+	static constexpr size_t INLINE_CAPACITY = 64;
+
+	Task() = default;
+	Task(std::nullptr_t) { }
+
+	template <typename F, typename = std::enable_if_t<!std::is_same_v<std::decay_t<F>, Task> && std::is_invocable_v<std::decay_t<F> &>>>
+	Task(F &&f, uint32_t delay = 0) :
+		delay(delay) {
+		using Callable = std::decay_t<F>;
+		if constexpr (isStoredInline<Callable>) {
+			::new (static_cast<void*>(storage)) Callable(std::forward<F>(f));
+			operations = &InlineOperations<Callable>::table;
+		} else {
+			static_assert(alignof(Callable) <= alignof(std::max_align_t), "Over-aligned task callables are not supported");
+			void* block = TaskPool::allocate(sizeof(Callable));
+			try {
+				::new (block) Callable(std::forward<F>(f));
+			} catch (...) {
+				TaskPool::deallocate(block, sizeof(Callable));
+				throw;
+			}
+			*reinterpret_cast<void**>(storage) = block;
+			operations = &PooledOperations<Callable>::table;
+		}
+	}
+
+	Task(Task &&other) noexcept :
+		delay(other.delay), eventId(other.eventId) {
+		moveFrom(other);
+	}
+
+	Task &operator=(Task &&other) noexcept {
+		if (this != &other) {
+			reset();
+			delay = other.delay;
+			eventId = other.eventId;
+			moveFrom(other);
+		}
+		return *this;
+	}
+
+	Task(const Task &) = delete;
+	Task &operator=(const Task &) = delete;
+
+	~Task() {
+		reset();
+	}
+
+	void operator()() {
+		operations->invoke(storage);
+	}
+
+	explicit operator bool() const {
+		return operations != nullptr;
+	}
+
+	void setEventId(uint64_t id) {
+		eventId = id;
+	}
+
+	uint64_t getEventId() const {
+		return eventId;
+	}
+
+	void setDelay(uint32_t newDelay) {
+		delay = newDelay;
+	}
+
+	uint32_t getDelay() const {
+		return delay;
+	}
+
+private:
+	struct Operations {
+		void (*invoke)(void* storage);
+		// Move constructs into destination and leaves source ready to be discarded
+		void (*relocate)(void* destination, void* source);
+		void (*destroy)(void* storage);
+	};
+
+	template <typename Callable>
+	static constexpr bool isStoredInline = sizeof(Callable) <= INLINE_CAPACITY
+		&& alignof(Callable) <= alignof(std::max_align_t)
+		&& std::is_nothrow_move_constructible_v<Callable>;
+
+	template <typename Callable>
+	struct InlineOperations {
+		static Callable* get(void* storage) {
+			return std::launder(reinterpret_cast<Callable*>(storage));
+		}
+
+		static constexpr Operations table {
+			[](void* storage) { (*get(storage))(); },
+			[](void* destination, void* source) {
+				::new (destination) Callable(std::move(*get(source)));
+				get(source)->~Callable();
+			},
+			[](void* storage) { get(storage)->~Callable(); },
+		};
+	};
+
+	template <typename Callable>
+	struct PooledOperations {
+		static Callable* get(void* storage) {
+			return *reinterpret_cast<Callable**>(storage);
+		}
+
+		static constexpr Operations table {
+			[](void* storage) { (*get(storage))(); },
+			[](void* destination, void* source) { *reinterpret_cast<Callable**>(destination) = get(source); },
+			[](void* storage) {
+				Callable* callable = get(storage);
+				callable->~Callable();
+				TaskPool::deallocate(callable, sizeof(Callable));
+			},
+		};
+	};
+
+	void moveFrom(Task &other) noexcept {
+		if (other.operations) {
+			other.operations->relocate(storage, other.storage);
+			operations = std::exchange(other.operations, nullptr);
+		}
+	}
+
+	void reset() noexcept {
+		if (operations) {
+			std::exchange(operations, nullptr)->destroy(storage);
+		}
+	}
+
+	alignas(std::max_align_t) std::byte storage[INLINE_CAPACITY];
+	const Operations* operations = nullptr;
+	uint32_t delay = 0;
+	uint64_t eventId = 0;
+};
@@ -56,8 +56,8 @@ asio::io_context &ThreadPool::getIoContext() {
 	return ioService;
 }
 
-void ThreadPool::addLoad(const std::function<void(void)> &load) {
-	asio::post(ioService, [this, load]() {
+void ThreadPool::addLoad(Task &&load) {
+	asio::post(ioService, [this, load = std::move(load)]() mutable {
 		if (ioService.stopped()) {
 			logger.error("Shutting down, cannot execute task.");
 			return;
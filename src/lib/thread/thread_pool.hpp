@@ -8,6 +8,8 @@
  */
 #pragma once
 
+#include "lib/thread/task.hpp"
+
 class ThreadPool {
 public:
 	explicit ThreadPool(Logger &logger);
@@ -19,7 +21,7 @@ public:
 	void start();
 	void shutdown();
 	asio::io_context &getIoContext();
-	void addLoad(const std::function<void(void)> &load);
+	void addLoad(Task &&load);
 
 private:
 	Logger &logger;
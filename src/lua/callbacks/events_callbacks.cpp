@@ -30,25 +30,55 @@ EventsCallbacks &EventsCallbacks::getInstance() {
 
 void EventsCallbacks::addCallback(const std::shared_ptr<EventCallback> &callback) {
 	m_callbacks.push_back(callback);
+	m_callbacksByType[static_cast<size_t>(callback->getType())].push_back(callback);
 }
 
-std::vector<std::shared_ptr<EventCallback>> EventsCallbacks::getCallbacks() const {
+const std::vector<std::shared_ptr<EventCallback>> &EventsCallbacks::getCallbacks() const {
 	return m_callbacks;
 }
 
-std::vector<std::shared_ptr<EventCallback>> EventsCallbacks::getCallbacksByType(EventCallback_t type) const {
-	std::vector<std::shared_ptr<EventCallback>> eventCallbacks;
-	for (auto callback : getCallbacks()) {
-		if (callback->getType() != type) {
-			continue;
-		}
+void EventsCallbacks::CallbackStats::add(int64_t microseconds) {
+	++invocations;
+	totalMicroseconds += microseconds;
 
-		eventCallbacks.push_back(callback);
+	size_t bucket = 0;
+	while (bucket < BUCKET_LIMITS.size() && microseconds >= BUCKET_LIMITS[bucket]) {
+		++bucket;
 	}
+	++buckets[bucket];
+}
 
-	return eventCallbacks;
+void EventsCallbacks::recordInvocation(EventCallback_t eventType, std::chrono::steady_clock::time_point start) {
+	const auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+	m_stats[static_cast<size_t>(eventType)].add(elapsed.count());
+}
+
+void EventsCallbacks::logStats() const {
+	static_assert(CallbackStats::BUCKET_LIMITS.size() == 4, "The log line below names every bucket");
+
+	std::vector<EventCallback_t> ranTypes;
+	for (auto type : magic_enum::enum_values<EventCallback_t>()) {
+		if (getStats(type).invocations > 0) {
+			ranTypes.push_back(type);
+		}
+	}
+
+	std::ranges::sort(ranTypes, [this](EventCallback_t lhs, EventCallback_t rhs) {
+		return getStats(lhs).totalMicroseconds > getStats(rhs).totalMicroseconds;
+	});
+
+	for (auto type : ranTypes) {
+		const CallbackStats &stats = getStats(type);
+		const auto &buckets = stats.buckets;
+		g_logger().info("Event callback {}: {} calls, {} ms total, {} us average, <10us/<100us/<1ms/<10ms/slower: {}/{}/{}/{}/{}", magic_enum::enum_name(type), stats.invocations, stats.totalMicroseconds / 1000, stats.totalMicroseconds / static_cast<int64_t>(stats.invocations), buckets[0], buckets[1], buckets[2], buckets[3], buckets[4]);
+	}
 }
 
 void EventsCallbacks::clear() {
+	logStats();
 	m_callbacks.clear();
+	for (auto &callbacks : m_callbacksByType) {
+		callbacks.clear();
+	}
+	m_stats.fill({});
 }
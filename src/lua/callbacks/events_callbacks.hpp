@@ -26,6 +26,22 @@ class EventCallback;
 
 class EventsCallbacks {
 public:
+	static constexpr size_t EVENT_CALLBACK_TYPE_COUNT = magic_enum::enum_count<EventCallback_t>();
+
+	/**
+	 * @brief Invocation count and run time of the callbacks of one event type.
+	 */
+	struct CallbackStats {
+		// Upper bounds in microseconds of every bucket but the last, which takes the slower runs
+		static constexpr std::array<int64_t, 4> BUCKET_LIMITS = { 10, 100, 1000, 10000 };
+
+		uint64_t invocations = 0;
+		int64_t totalMicroseconds = 0;
+		std::array<uint64_t, BUCKET_LIMITS.size() + 1> buckets {};
+
+		void add(int64_t microseconds);
+	};
+
 	/**
 	 * @brief Default constructor.
 	 */
@@ -55,17 +71,31 @@ public:
 	 * @brief Gets all registered event callbacks.
 	 * @return Vector of pointers to EventCallback objects.
 	 */
-	std::vector<std::shared_ptr<EventCallback>> getCallbacks() const;
+	const std::vector<std::shared_ptr<EventCallback>> &getCallbacks() const;
 
 	/**
 	 * @brief Gets event callbacks by their type.
 	 * @param type The type of callbacks to retrieve.
-	 * @return Vector of pointers to EventCallback objects of the specified type.
+	 * @return Vector of pointers to EventCallback objects of the specified type, bucketed when they were added.
 	 */
-	std::vector<std::shared_ptr<EventCallback>> getCallbacksByType(EventCallback_t type) const;
+	const std::vector<std::shared_ptr<EventCallback>> &getCallbacksByType(EventCallback_t type) const {
+		return m_callbacksByType[static_cast<size_t>(type)];
+	}
 
 	/**
-	 * @brief Clears all registered event callbacks.
+	 * @brief Gets the invocation count and run time histogram of the callbacks of a type since the last clear.
+	 */
+	const CallbackStats &getStats(EventCallback_t type) const {
+		return m_stats[static_cast<size_t>(type)];
+	}
+
+	/**
+	 * @brief Logs the stats of every type that ran, the most expensive first.
+	 */
+	void logStats() const;
+
+	/**
+	 * @brief Clears all registered event callbacks, logging and resetting their stats.
 	 */
 	void clear();
 
@@ -74,12 +104,19 @@ public:
 	 * @param eventType The type of event to trigger.
 	 * @param callbackFunc Function pointer to the callback method.
 	 * @param args Variadic arguments to pass to the callback function.
+	 * @note Iterates by index and holds each callback while it runs, so a callback may register
+	 * new callbacks or clear them all meanwhile.
 	 */
 	template <typename CallbackFunc, typename... Args>
 	void executeCallback(EventCallback_t eventType, CallbackFunc callbackFunc, Args &&... args) {
-		for (const auto &callback : getCallbacksByType(eventType)) {
+		const auto &callbacks = getCallbacksByType(eventType);
+		for (size_t i = 0; i < callbacks.size(); ++i) {
+			// A copy, the bucket may be cleared or reallocated by the callback itself
+			const std::shared_ptr<EventCallback> callback = callbacks[i];
 			if (callback && callback->isLoadedCallback()) {
+				const auto start = std::chrono::steady_clock::now();
 				((*callback).*callbackFunc)(std::forward<Args>(args)...);
+				recordInvocation(eventType, start);
 			}
 		}
 	}
@@ -95,9 +132,14 @@ public:
 	bool checkCallback(EventCallback_t eventType, CallbackFunc callbackFunc, Args &&... args) {
 		bool allCallbacksSucceeded = true;
 
-		for (const auto &callback : getCallbacksByType(eventType)) {
+		const auto &callbacks = getCallbacksByType(eventType);
+		for (size_t i = 0; i < callbacks.size(); ++i) {
+			// A copy, the bucket may be cleared or reallocated by the callback itself
+			const std::shared_ptr<EventCallback> callback = callbacks[i];
 			if (callback && callback->isLoadedCallback()) { // Verifique se o callback é não nulo
+				const auto start = std::chrono::steady_clock::now();
 				bool callbackResult = ((*callback).*callbackFunc)(std::forward<Args>(args)...);
+				recordInvocation(eventType, start);
 				allCallbacksSucceeded = allCallbacksSucceeded && callbackResult;
 			}
 		}
@@ -105,8 +147,13 @@ public:
 	}
 
 private:
+	void recordInvocation(EventCallback_t eventType, std::chrono::steady_clock::time_point start);
+
 	// Container for storing registered event callbacks.
 	std::vector<std::shared_ptr<EventCallback>> m_callbacks;
+	// The same callbacks indexed by EventCallback_t, so dispatching neither copies nor filters them
+	std::array<std::vector<std::shared_ptr<EventCallback>>, EVENT_CALLBACK_TYPE_COUNT> m_callbacksByType;
+	std::array<CallbackStats, EVENT_CALLBACK_TYPE_COUNT> m_stats;
 };
 
 constexpr auto g_callbacks = EventsCallbacks::getInstance;
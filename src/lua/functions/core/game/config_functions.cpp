@@ -78,6 +78,7 @@ void ConfigFunctions::init(lua_State* L) {
 	registerEnumIn(L, "configKeys", STORE_IMAGES_URL);
 	registerEnumIn(L, "configKeys", PARTY_LIST_MAX_DISTANCE);
 	registerEnumIn(L, "configKeys", SQL_PORT);
+	registerEnumIn(L, "configKeys", SQL_POOL_SIZE);
 	registerEnumIn(L, "configKeys", MAX_PLAYERS);
 	registerEnumIn(L, "configKeys", PZ_LOCKED);
 	registerEnumIn(L, "configKeys", DEFAULT_DESPAWNRANGE);
@@ -167,6 +168,9 @@ void ConfigFunctions::init(lua_State* L) {
 	registerEnumIn(L, "configKeys", SAVE_INTERVAL_TYPE);
 	registerEnumIn(L, "configKeys", TOGGLE_SAVE_INTERVAL_CLEAN_MAP);
 	registerEnumIn(L, "configKeys", SAVE_INTERVAL_TIME);
+	registerEnumIn(L, "configKeys", TOGGLE_SAVE_ASYNC);
+	registerEnumIn(L, "configKeys", SAVE_ASYNC_WINDOW);
+	registerEnumIn(L, "configKeys", HIGHSCORES_REFRESH_INTERVAL);
 	registerEnumIn(L, "configKeys", RATE_USE_STAGES);
 	registerEnumIn(L, "configKeys", TOGGLE_IMBUEMENT_SHRINE_STORAGE);
 	registerEnumIn(L, "configKeys", GLOBAL_SERVER_SAVE_TIME);
@@ -1026,6 +1026,7 @@ void LuaEnums::initTileStateEnums(lua_State* L) {
 	registerEnum(L, TILESTATE_FLOORCHANGE_SOUTH_ALT);
 	registerEnum(L, TILESTATE_FLOORCHANGE_EAST_ALT);
 	registerEnum(L, TILESTATE_SUPPORTS_HANGABLE);
+	registerEnum(L, TILESTATE_BLOCKPROJECTILE);
 }
 
 // Use with npc:setSpeechBubble
@@ -11,6 +11,7 @@
 
 #include "map.hpp"
 #include "utils/astarnodes.hpp"
+#include "utils/sightmask.hpp"
 
 #include "creatures/monsters/monster.hpp"
 #include "game/game.hpp"
@@ -20,6 +21,7 @@
 bool Map::load(const std::string &identifier, const Position &pos, bool unload) {
 	try {
 		IOMap::loadMap(this, identifier, pos, unload);
+		logMemoryUsage();
 		return true;
 	} catch (const IOMapException &e) {
 		g_logger().error("[Map::load] - {}", e.what());
@@ -131,6 +133,44 @@ bool Map::save() {
 	return false;
 }
 
+std::array<Map::FloorMemoryUsage, MAP_MAX_LAYERS> Map::getFloorMemoryUsage() const {
+	std::array<FloorMemoryUsage, MAP_MAX_LAYERS> usage {};
+	root.forEachLeaf([&usage](const QTreeLeafNode &leaf) {
+		for (uint8_t z = 0; z < MAP_MAX_LAYERS; ++z) {
+			const auto &floor = leaf.getFloor(z);
+			if (!floor) {
+				continue;
+			}
+
+			FloorMemoryUsage &floorUsage = usage[z];
+			++floorUsage.blocks;
+			floorUsage.cachedTiles += floor->getCachedTileCount();
+			floorUsage.tiles += floor->getTileCount();
+			floorUsage.bytes += floor->getMemoryUsage();
+		}
+	});
+	return usage;
+}
+
+void Map::logMemoryUsage() const {
+	FloorMemoryUsage total;
+	const auto usage = getFloorMemoryUsage();
+	for (uint8_t z = 0; z < MAP_MAX_LAYERS; ++z) {
+		const FloorMemoryUsage &floorUsage = usage[z];
+		if (floorUsage.blocks == 0) {
+			continue;
+		}
+
+		g_logger().debug("Map floor {}: {} blocks, {} cached tiles, {} tiles, {} kB", z, floorUsage.blocks, floorUsage.cachedTiles, floorUsage.tiles, floorUsage.bytes / 1024);
+		total.blocks += floorUsage.blocks;
+		total.cachedTiles += floorUsage.cachedTiles;
+		total.tiles += floorUsage.tiles;
+		total.bytes += floorUsage.bytes;
+	}
+
+	g_logger().info("Map storage: {} blocks, {} cached tiles sharing {} templates, {} tiles, {} kB", total.blocks, total.cachedTiles, getBasicTileCount(), total.tiles, total.bytes / 1024);
+}
+
 Tile* Map::getOrCreateTile(uint16_t x, uint16_t y, uint8_t z, bool isDynamic) {
 	auto tile = getTile(x, y, z);
 	if (!tile) {
@@ -167,7 +207,32 @@ void Map::setTile(uint16_t x, uint16_t y, uint8_t z, Tile* newTile) {
 		return;
 	}
 
-	root.getBestLeaf(x, y, 15)->createFloor(z)->setTile(x, y, newTile);
+	const auto &floor = root.getBestLeaf(x, y, 15)->createFloor(z);
+	floor->setTile(x, y, newTile);
+
+	// A tile created from the cache has the flags its template already stored
+	const uint8_t blocking = newTile ? newTile->getBlocking() : TILE_BLOCKING_PATH;
+	if (floor->getBlocking(x, y) != blocking) {
+		floor->setBlocking(x, y, blocking);
+		clearFlowFields(Position(x, y, z));
+	}
+}
+
+void Map::updateTileBlocking(const Tile &tile) {
+	const Position &pos = tile.getPosition();
+	Floor* floor = getFloor(pos.x, pos.y, pos.z);
+	// A tile still being created from the cache is not placed yet, its floor already holds the template's flags
+	if (!floor || floor->getTile(pos.x, pos.y) != &tile) {
+		return;
+	}
+
+	const uint8_t blocking = tile.getBlocking();
+	if (floor->getBlocking(pos.x, pos.y) == blocking) {
+		return;
+	}
+
+	floor->setBlocking(pos.x, pos.y, blocking);
+	clearFlowFields(pos);
 }
 
 bool Map::placeCreature(const Position &centerPos, Creature* creature, bool extendedPos /* = false*/, bool forceLogin /* = false*/) {
@@ -395,101 +460,138 @@ void Map::getSpectatorsInternal(SpectatorHashSet &spectators, const Position &ce
 	}
 }
 
+uint64_t Map::getSpectatorCacheKey(const Position &centerPos, bool multifloor, bool onlyPlayers, int32_t minRangeX, int32_t maxRangeX, int32_t minRangeY, int32_t maxRangeY) {
+	// Ranges are shifted to be positive, each one fits in 6 bits
+	const auto packRange = [](int32_t range) {
+		return static_cast<uint64_t>(range + SPECTATOR_CACHE_MAX_RANGE);
+	};
+
+	return static_cast<uint64_t>(centerPos.x)
+		| (static_cast<uint64_t>(centerPos.y) << 16)
+		| (static_cast<uint64_t>(centerPos.z & 0x0F) << 32)
+		| (packRange(minRangeX) << 36)
+		| (packRange(maxRangeX) << 42)
+		| (packRange(minRangeY) << 48)
+		| (packRange(maxRangeY) << 54)
+		| (static_cast<uint64_t>(multifloor) << 60)
+		| (static_cast<uint64_t>(onlyPlayers) << 61);
+}
+
 void Map::getSpectators(SpectatorHashSet &spectators, const Position &centerPos, bool multifloor /*= false*/, bool onlyPlayers /*= false*/, int32_t minRangeX /*= 0*/, int32_t maxRangeX /*= 0*/, int32_t minRangeY /*= 0*/, int32_t maxRangeY /*= 0*/) {
 	if (centerPos.z >= MAP_MAX_LAYERS) {
 		return;
 	}
 
-	bool foundCache = false;
-	bool cacheResult = false;
-
 	minRangeX = (minRangeX == 0 ? -MAP_MAX_VIEW_PORT_X : -minRangeX);
 	maxRangeX = (maxRangeX == 0 ? MAP_MAX_VIEW_PORT_X : maxRangeX);
 	minRangeY = (minRangeY == 0 ? -MAP_MAX_VIEW_PORT_Y : -minRangeY);
 	maxRangeY = (maxRangeY == 0 ? MAP_MAX_VIEW_PORT_Y : maxRangeY);
 
-	if (minRangeX == -MAP_MAX_VIEW_PORT_X && maxRangeX == MAP_MAX_VIEW_PORT_X && minRangeY == -MAP_MAX_VIEW_PORT_Y && maxRangeY == MAP_MAX_VIEW_PORT_Y && multifloor) {
-		if (onlyPlayers) {
-			auto it = playersSpectatorCache.find(centerPos);
-			if (it != playersSpectatorCache.end()) {
-				if (!spectators.empty()) {
-					const SpectatorHashSet &cachedSpectators = it->second;
-					spectators.insert(cachedSpectators.begin(), cachedSpectators.end());
-				} else {
-					spectators = it->second;
+	const auto mergeCached = [&spectators](const SpectatorHashSet &cachedSpectators, bool filterPlayers) {
+		if (filterPlayers) {
+			for (Creature* spectator : cachedSpectators) {
+				if (spectator->getPlayer()) {
+					spectators.insert(spectator);
 				}
-
-				foundCache = true;
 			}
+		} else if (spectators.empty()) {
+			spectators = cachedSpectators;
+		} else {
+			spectators.insert(cachedSpectators.begin(), cachedSpectators.end());
 		}
+	};
 
-		if (!foundCache) {
-			auto it = spectatorCache.find(centerPos);
-			if (it != spectatorCache.end()) {
-				if (!onlyPlayers) {
-					if (!spectators.empty()) {
-						const SpectatorHashSet &cachedSpectators = it->second;
-						spectators.insert(cachedSpectators.begin(), cachedSpectators.end());
-					} else {
-						spectators = it->second;
-					}
-				} else {
-					const SpectatorHashSet &cachedSpectators = it->second;
-					for (Creature* spectator : cachedSpectators) {
-						if (spectator->getPlayer()) {
-							spectators.insert(spectator);
-						}
-					}
-				}
+	// Queries are cached in the sector of their center, clearSpectatorCache drops them when a creature nearby changes
+	QTreeLeafNode* leaf = nullptr;
+	uint64_t cacheKey = 0;
+	if (std::max({ std::abs(minRangeX), std::abs(maxRangeX), std::abs(minRangeY), std::abs(maxRangeY) }) <= SPECTATOR_CACHE_MAX_RANGE) {
+		leaf = getQTNode(centerPos.x, centerPos.y);
+	}
 
-				foundCache = true;
-			} else {
-				cacheResult = true;
+	if (leaf) {
+		cacheKey = getSpectatorCacheKey(centerPos, multifloor, onlyPlayers, minRangeX, maxRangeX, minRangeY, maxRangeY);
+		if (auto it = leaf->spectatorCache.find(cacheKey); it != leaf->spectatorCache.end()) {
+			mergeCached(it->second, false);
+			return;
+		}
+
+		// Players are a subset of the same query with every creature
+		if (onlyPlayers) {
+			const uint64_t creaturesKey = getSpectatorCacheKey(centerPos, multifloor, false, minRangeX, maxRangeX, minRangeY, maxRangeY);
+			if (auto it = leaf->spectatorCache.find(creaturesKey); it != leaf->spectatorCache.end()) {
+				mergeCached(it->second, true);
+				return;
 			}
 		}
 	}
 
-	if (!foundCache) {
-		int32_t minRangeZ;
-		int32_t maxRangeZ;
-
-		if (multifloor) {
-			if (centerPos.z > MAP_INIT_SURFACE_LAYER) {
-				// underground
-
-				// 8->15
-				minRangeZ = std::max<int32_t>(centerPos.getZ() - MAP_LAYER_VIEW_LIMIT, 0);
-				maxRangeZ = std::min<int32_t>(centerPos.getZ() + MAP_LAYER_VIEW_LIMIT, MAP_MAX_LAYERS - 1);
-			} else if (centerPos.z == MAP_INIT_SURFACE_LAYER - 1) {
-				minRangeZ = 0;
-				maxRangeZ = (MAP_INIT_SURFACE_LAYER - 1) + MAP_LAYER_VIEW_LIMIT;
-			} else if (centerPos.z == MAP_INIT_SURFACE_LAYER) {
-				minRangeZ = 0;
-				maxRangeZ = MAP_INIT_SURFACE_LAYER + MAP_LAYER_VIEW_LIMIT;
-			} else {
-				minRangeZ = 0;
-				maxRangeZ = MAP_INIT_SURFACE_LAYER;
-			}
+	int32_t minRangeZ;
+	int32_t maxRangeZ;
+
+	if (multifloor) {
+		if (centerPos.z > MAP_INIT_SURFACE_LAYER) {
+			// underground
+
+			// 8->15
+			minRangeZ = std::max<int32_t>(centerPos.getZ() - MAP_LAYER_VIEW_LIMIT, 0);
+			maxRangeZ = std::min<int32_t>(centerPos.getZ() + MAP_LAYER_VIEW_LIMIT, MAP_MAX_LAYERS - 1);
+		} else if (centerPos.z == MAP_INIT_SURFACE_LAYER - 1) {
+			minRangeZ = 0;
+			maxRangeZ = (MAP_INIT_SURFACE_LAYER - 1) + MAP_LAYER_VIEW_LIMIT;
+		} else if (centerPos.z == MAP_INIT_SURFACE_LAYER) {
+			minRangeZ = 0;
+			maxRangeZ = MAP_INIT_SURFACE_LAYER + MAP_LAYER_VIEW_LIMIT;
 		} else {
-			minRangeZ = centerPos.z;
-			maxRangeZ = centerPos.z;
+			minRangeZ = 0;
+			maxRangeZ = MAP_INIT_SURFACE_LAYER;
 		}
+	} else {
+		minRangeZ = centerPos.z;
+		maxRangeZ = centerPos.z;
+	}
 
+	if (!leaf) {
 		getSpectatorsInternal(spectators, centerPos, minRangeX, maxRangeX, minRangeY, maxRangeY, minRangeZ, maxRangeZ, onlyPlayers);
+		return;
+	}
 
-		if (cacheResult) {
-			if (onlyPlayers) {
-				playersSpectatorCache[centerPos] = spectators;
+	// Only the result of this query goes into the cache, not what the caller already collected
+	if (spectators.empty()) {
+		getSpectatorsInternal(spectators, centerPos, minRangeX, maxRangeX, minRangeY, maxRangeY, minRangeZ, maxRangeZ, onlyPlayers);
+		leaf->spectatorCache.emplace(cacheKey, spectators);
+	} else {
+		SpectatorHashSet result;
+		getSpectatorsInternal(result, centerPos, minRangeX, maxRangeX, minRangeY, maxRangeY, minRangeZ, maxRangeZ, onlyPlayers);
+		spectators.insert(result.begin(), result.end());
+		leaf->spectatorCache.emplace(cacheKey, std::move(result));
+	}
+}
+
+void Map::clearSpectatorCache(const Position &pos) {
+	// Every cached query that can see this position is centered within the margin
+	const int32_t startX = std::max<int32_t>(0, pos.x - SPECTATOR_CACHE_MARGIN) & ~FLOOR_MASK;
+	const int32_t startY = std::max<int32_t>(0, pos.y - SPECTATOR_CACHE_MARGIN) & ~FLOOR_MASK;
+	const int32_t endX = std::min<int32_t>(0xFFFF, pos.x + SPECTATOR_CACHE_MARGIN);
+	const int32_t endY = std::min<int32_t>(0xFFFF, pos.y + SPECTATOR_CACHE_MARGIN);
+
+	QTreeLeafNode* leafS = getQTNode(startX, startY);
+	for (int32_t ny = startY; ny <= endY; ny += FLOOR_SIZE) {
+		QTreeLeafNode* leafE = leafS;
+		for (int32_t nx = startX; nx <= endX; nx += FLOOR_SIZE) {
+			if (leafE) {
+				leafE->spectatorCache.clear();
+				leafE = leafE->leafE;
 			} else {
-				spectatorCache[centerPos] = spectators;
+				leafE = getQTNode(nx + FLOOR_SIZE, ny);
 			}
 		}
-	}
-}
 
-void Map::clearSpectatorCache() {
-	spectatorCache.clear();
-	playersSpectatorCache.clear();
+		if (leafS) {
+			leafS = leafS->leafS;
+		} else {
+			leafS = getQTNode(startX, ny + FLOOR_SIZE);
+		}
+	}
 }
 
 bool Map::canThrowObjectTo(const Position &fromPos, const Position &toPos, bool checkLineOfSight /*= true*/, int32_t rangex /*= MAP_MAX_CLIENT_VIEW_PORT_X*/, int32_t rangey /*= MAP_MAX_CLIENT_VIEW_PORT_Y*/) {
@@ -528,32 +630,11 @@ bool Map::checkSightLine(const Position &fromPos, const Position &toPos) {
 	Position start(fromPos.z > toPos.z ? toPos : fromPos);
 	Position destination(fromPos.z > toPos.z ? fromPos : toPos);
 
-	const int8_t mx = start.x < destination.x ? 1 : start.x == destination.x ? 0
-																			 : -1;
-	const int8_t my = start.y < destination.y ? 1 : start.y == destination.y ? 0
-																			 : -1;
-
-	int32_t A = Position::getOffsetY(destination, start);
-	int32_t B = Position::getOffsetX(start, destination);
-	int32_t C = -(A * destination.x + B * destination.y);
-
-	while (start.x != destination.x || start.y != destination.y) {
-		int32_t move_hor = std::abs(A * (start.x + mx) + B * (start.y) + C);
-		int32_t move_ver = std::abs(A * (start.x) + B * (start.y + my) + C);
-		int32_t move_cross = std::abs(A * (start.x + mx) + B * (start.y + my) + C);
-
-		if (start.y != destination.y && (start.x == destination.x || move_hor > move_ver || move_hor > move_cross)) {
-			start.y += my;
-		}
-
-		if (start.x != destination.x && (start.y == destination.y || move_ver > move_hor || move_ver > move_cross)) {
-			start.x += mx;
-		}
-
-		const Tile* tile = getTile(start.x, start.y, start.z);
-		if (tile && tile->hasProperty(CONST_PROP_BLOCKPROJECTILE)) {
-			return false;
-		}
+	TileBlockingReader blockingReader(*this, start.z);
+	if (!SightMask::walkLine(start, destination, [&blockingReader](uint16_t x, uint16_t y) {
+			return blockingReader.has(x, y, TILE_BLOCKING_PROJECTILE);
+		})) {
+		return false;
 	}
 
 	// now we need to perform a jump between floors to see if everything is clear (literally)
@@ -586,7 +667,11 @@ const Tile* Map::canWalkTo(const Creature &creature, const Position &pos) {
 		return getTile(pos.x, pos.y, pos.z);
 	}
 
-	// used for non-cached tiles
+	// used for non-cached tiles, the bitmaps rule out what no creature can enter without creating the tile
+	if (pos != creature.getPosition() && hasTileBlocking(pos.x, pos.y, pos.z, TILE_BLOCKING_PATH)) {
+		return nullptr;
+	}
+
 	Tile* tile = getTile(pos.x, pos.y, pos.z);
 	if (creature.getTile() != tile) {
 		if (!tile || tile->queryAdd(0, creature, 1, FLAG_PATHFINDING | FLAG_IGNOREFIELDDAMAGE) != RETURNVALUE_NOERROR) {
@@ -685,6 +770,10 @@ bool Map::getPathMatching(const Creature &creature, std::forward_list<Direction>
 				continue;
 			}
 
+			if (!nodes.isInSearchArea(pos.x, pos.y)) {
+				continue;
+			}
+
 			if (fpp.keepDistance && !pathCondition.isInRange(startPos, pos, fpp)) {
 				continue;
 			}
@@ -770,6 +859,58 @@ bool Map::getPathMatching(const Creature &creature, std::forward_list<Direction>
 	return true;
 }
 
+bool Map::getPathFromFlowField(const Creature &creature, const Creature &target, std::forward_list<Direction> &dirList, const FindPathParams &fpp) {
+	if (!creature.getMonster() || fpp.keepDistance || fpp.minTargetDist > 1 || fpp.maxTargetDist != 1) {
+		return false;
+	}
+
+	const Position &targetPos = target.getPosition();
+	Position pos = creature.getPosition();
+	if (!FlowField::isInRange(targetPos, pos)) {
+		return false;
+	}
+
+	// Built aside and only then stored, the map must not hand out a field that is still being written
+	auto it = flowFields.find(target.getID());
+	if (it == flowFields.end() || !it->second.isBuiltFor(targetPos)) {
+		FlowField newField;
+		newField.build(*this, targetPos);
+		it = flowFields.insert_or_assign(target.getID(), std::move(newField)).first;
+	}
+	// Copied, checking the steps below may create tiles and change the stored fields
+	const FlowField field = it->second;
+
+	const auto canWalk = [this, &creature](const Position &nextPos) {
+		return canWalkTo(creature, nextPos);
+	};
+
+	auto last = dirList.before_begin();
+	uint16_t cost = field.getCost(pos);
+	while (cost != 0 && cost != FlowField::UNREACHABLE) {
+		Position nextPos;
+		const Direction dir = field.getNextStep(pos, canWalk, nextPos);
+		if (dir == DIRECTION_NONE) {
+			// Blocked by creatures or fields, walk as far as we got and look again from there
+			break;
+		}
+
+		last = dirList.insert_after(last, dir);
+		pos = nextPos;
+		cost = field.getCost(pos);
+	}
+	return !dirList.empty();
+}
+
+void Map::clearFlowFields(const Position &pos) {
+	if (flowFields.empty()) {
+		return;
+	}
+
+	phmap::erase_if(flowFields, [&pos](const auto &it) {
+		return FlowField::isInRange(it.second.getTargetPosition(), pos);
+	});
+}
+
 bool Map::getPathMatching(const Position &start, std::forward_list<Direction> &dirList, const FrozenPathingConditionCall &pathCondition, const FindPathParams &fpp) {
 	Position pos = start;
 	Position endPos;
@@ -859,6 +1000,10 @@ bool Map::getPathMatching(const Position &start, std::forward_list<Direction> &d
 				continue;
 			}
 
+			if (!nodes.isInSearchArea(pos.x, pos.y)) {
+				continue;
+			}
+
 			if (fpp.keepDistance && !pathCondition.isInRange(startPos, pos, fpp)) {
 				continue;
 			}
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "mapcache.hpp"
+#include "map/utils/flowfield.hpp"
 #include "map/town.hpp"
 #include "map/house/house.hpp"
 #include "creatures/monsters/spawns/spawn_monster.hpp"
@@ -23,8 +24,6 @@ class Map;
 
 struct FindPathParams;
 
-using SpectatorCache = std::map<Position, SpectatorHashSet>;
-
 class FrozenPathingConditionCall;
 
 /**
@@ -94,7 +93,11 @@ public:
 
 	void getSpectators(SpectatorHashSet &spectators, const Position &centerPos, bool multifloor = false, bool onlyPlayers = false, int32_t minRangeX = 0, int32_t maxRangeX = 0, int32_t minRangeY = 0, int32_t maxRangeY = 0);
 
-	void clearSpectatorCache();
+	/**
+	 * Drops the cached spectator queries that may contain a creature at this position.
+	 * Must be called whenever a creature is added to or removed from a tile.
+	 */
+	void clearSpectatorCache(const Position &pos);
 
 	/**
 	 * Checks if you can throw an object to that position
@@ -120,10 +123,60 @@ public:
 
 	const Tile* canWalkTo(const Creature &creature, const Position &pos);
 
+	/**
+	 * Stores the TileBlocking_t flags of a placed tile in its floor's bitmaps and
+	 * drops the flow fields covering it if they changed. Called by the tile whenever
+	 * an item changes them.
+	 */
+	void updateTileBlocking(const Tile &tile);
+
+	/**
+	 * Reads a TileBlocking_t flag of a position without creating its tile.
+	 * A position no floor block was ever created for has no ground to path into.
+	 */
+	bool hasTileBlocking(uint16_t x, uint16_t y, uint8_t z, TileBlocking_t blocking) {
+		const Floor* floor = getFloor(x, y, z);
+		return floor ? floor->hasBlocking(x, y, blocking) : blocking == TILE_BLOCKING_PATH;
+	}
+
+	Floor* getFloor(uint16_t x, uint16_t y, uint8_t z) {
+		const QTreeLeafNode* leaf = z < MAP_MAX_LAYERS ? getQTNode(x, y) : nullptr;
+		return leaf ? leaf->getFloor(z).get() : nullptr;
+	}
+
 	bool getPathMatching(const Creature &creature, std::forward_list<Direction> &dirList, const FrozenPathingConditionCall &pathCondition, const FindPathParams &fpp);
 
 	bool getPathMatching(const Position &startPos, std::forward_list<Direction> &dirList, const FrozenPathingConditionCall &pathCondition, const FindPathParams &fpp);
 
+	/**
+	 * Reads the path to a followed creature from the flow field shared by all of its followers.
+	 * Only covers plain melee follows on the same floor, the caller falls back to getPathMatching otherwise.
+	 *	\returns true if at least one step towards the target was found
+	 */
+	bool getPathFromFlowField(const Creature &creature, const Creature &target, std::forward_list<Direction> &dirList, const FindPathParams &fpp);
+
+	/**
+	 * Drops the flow fields that cover this position.
+	 * Must be called whenever the walkability of a tile changes.
+	 */
+	void clearFlowFields(const Position &pos);
+	void removeFlowField(uint32_t targetId) {
+		flowFields.erase(targetId);
+	}
+
+	struct FloorMemoryUsage {
+		// 8x8 blocks holding anything on this floor
+		size_t blocks = 0;
+		// Cells still waiting as a template id
+		size_t cachedTiles = 0;
+		size_t tiles = 0;
+		// Block storage only, the tiles themselves and their items are not counted
+		size_t bytes = 0;
+	};
+
+	std::array<FloorMemoryUsage, MAP_MAX_LAYERS> getFloorMemoryUsage() const;
+	void logMemoryUsage() const;
+
 	std::map<std::string, Position> waypoints;
 
 	QTreeLeafNode* getQTNode(uint16_t x, uint16_t y) {
@@ -150,9 +203,6 @@ private:
 		setTile(pos.x, pos.y, pos.z, newTile);
 	}
 
-	SpectatorCache spectatorCache;
-	SpectatorCache playersSpectatorCache;
-
 	std::string monsterfile;
 	std::string housefile;
 	std::string npcfile;
@@ -160,6 +210,11 @@ private:
 	uint32_t width = 0;
 	uint32_t height = 0;
 
+	static uint64_t getSpectatorCacheKey(const Position &centerPos, bool multifloor, bool onlyPlayers, int32_t minRangeX, int32_t maxRangeX, int32_t minRangeY, int32_t maxRangeY);
+
+	// Followed creature id -> flow field towards it
+	phmap::flat_hash_map<uint32_t, FlowField> flowFields;
+
 	// Actually scans the map for spectators
 	void getSpectatorsInternal(SpectatorHashSet &spectators, const Position &centerPos, int32_t minRangeX, int32_t maxRangeX, int32_t minRangeY, int32_t maxRangeY, int32_t minRangeZ, int32_t maxRangeZ, bool onlyPlayers) const;
 
@@ -167,3 +222,40 @@ private:
 	friend class IOMap;
 	friend class MapCache;
 };
+
+/**
+ * Reads the blocking bitmaps of nearby positions of one floor, such as a
+ * sight line or a creature's walk cache, looking the floor block up again
+ * only when a position falls outside the previous one's block.
+ */
+class TileBlockingReader {
+public:
+	TileBlockingReader(Map &map, uint8_t z) :
+		map(map), z(z) { }
+
+	bool has(uint16_t x, uint16_t y, TileBlocking_t blocking) {
+		const Floor* floor = getFloor(x, y);
+		return floor ? floor->hasBlocking(x, y, blocking) : blocking == TILE_BLOCKING_PATH;
+	}
+
+	// All TileBlocking_t flags of the position at once
+	uint8_t get(uint16_t x, uint16_t y) {
+		const Floor* floor = getFloor(x, y);
+		return floor ? floor->getBlocking(x, y) : TILE_BLOCKING_PATH;
+	}
+
+private:
+	const Floor* getFloor(uint16_t x, uint16_t y) {
+		const uint32_t blockKey = (static_cast<uint32_t>(x >> FLOOR_BITS) << 16) | (y >> FLOOR_BITS);
+		if (blockKey != currentBlockKey) {
+			currentBlockKey = blockKey;
+			currentFloor = map.getFloor(x, y, z);
+		}
+		return currentFloor;
+	}
+
+	Map &map;
+	const Floor* currentFloor = nullptr;
+	uint32_t currentBlockKey = std::numeric_limits<uint32_t>::max();
+	uint8_t z;
+};
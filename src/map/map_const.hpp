@@ -21,3 +21,13 @@ static constexpr int8_t MAP_LAYER_VIEW_LIMIT = 2;
 static constexpr int32_t FLOOR_BITS = 3;
 static constexpr int32_t FLOOR_SIZE = (1 << FLOOR_BITS);
 static constexpr int32_t FLOOR_MASK = (FLOOR_SIZE - 1);
+
+// Step costs of the path searches, diagonal steps cost more unless the search prefers them
+static constexpr int32_t MAP_NORMALWALKCOST = 10;
+static constexpr int32_t MAP_PREFERDIAGONALWALKCOST = 14;
+static constexpr int32_t MAP_DIAGONALWALKCOST = 25;
+
+// Spectator queries with every range up to this value are cached per sector
+static constexpr int32_t SPECTATOR_CACHE_MAX_RANGE = MAP_MAX_VIEW_PORT_X;
+// Creatures on other floors are seen shifted by the floor difference, at most from the surface down to the sky
+static constexpr int32_t SPECTATOR_CACHE_MARGIN = SPECTATOR_CACHE_MAX_RANGE + MAP_INIT_SURFACE_LAYER;
@@ -22,20 +22,37 @@
 
 #include "io/iomap.hpp"
 
-static phmap::flat_hash_map<size_t, BasicItemPtr> items;
-static phmap::flat_hash_map<size_t, BasicTilePtr> tiles;
+// Lock striped, tile areas are decoded by several threads at once
+template <typename T>
+using CacheTable = phmap::parallel_flat_hash_map<size_t, T, phmap::Hash<size_t>, phmap::EqualTo<size_t>, phmap::Allocator<std::pair<const size_t, T>>, 4, std::mutex>;
+
+static CacheTable<BasicItemPtr> items;
+static CacheTable<BasicTilePtr> tiles;
+
+template <typename T>
+static std::shared_ptr<T> static_tryGetFromCache(CacheTable<std::shared_ptr<T>> &table, const std::shared_ptr<T> &ref) {
+	if (!ref) {
+		return nullptr;
+	}
+
+	// The cached value is read while its stripe is still locked
+	std::shared_ptr<T> cached = ref;
+	table.try_emplace_l(ref->hash(), [&cached](const auto &it) { cached = it.second; }, ref);
+	return cached;
+}
 
 BasicItemPtr static_tryGetItemFromCache(const BasicItemPtr &ref) {
-	return ref ? items.try_emplace(ref->hash(), ref).first->second : nullptr;
+	return static_tryGetFromCache(items, ref);
 }
 
 BasicTilePtr static_tryGetTileFromCache(const BasicTilePtr &ref) {
-	return ref ? tiles.try_emplace(ref->hash(), ref).first->second : nullptr;
+	return static_tryGetFromCache(tiles, ref);
 }
 
 void MapCache::flush() {
 	items.clear();
 	tiles.clear();
+	basicTileIds.clear();
 }
 
 void MapCache::parseItemAttr(const BasicItemPtr &BasicItem, Item* item) {
@@ -94,6 +111,7 @@ Item* MapCache::createItem(const BasicItemPtr &BasicItem, Position position) {
 			if (auto itemInsede = createItem(BasicItemInside, position)) {
 				item->getContainer()->addItem(itemInsede);
 				item->getContainer()->updateItemWeight(itemInsede->getWeight());
+				item->getContainer()->addContentItemCounts(itemInsede);
 			}
 		}
 	}
@@ -108,10 +126,12 @@ Item* MapCache::createItem(const BasicItemPtr &BasicItem, Position position) {
 }
 
 Tile* MapCache::getOrCreateTileFromCache(const std::unique_ptr<Floor> &floor, uint16_t x, uint16_t y) {
-	const auto &cachedTile = floor->getTileCache(x, y);
-	if (!cachedTile)
+	const uint32_t cacheId = floor->getTileCacheId(x, y);
+	if (cacheId == 0)
 		return floor->getTile(x, y);
 
+	const auto &cachedTile = basicTiles[cacheId];
+
 	const uint8_t z = floor->getZ();
 
 	auto map = static_cast<Map*>(this);
@@ -139,24 +159,96 @@ Tile* MapCache::getOrCreateTileFromCache(const std::unique_ptr<Floor> &floor, ui
 	floor->setTile(x, y, tile);
 
 	// Remove Tile from cache
-	floor->setTileCache(x, y, nullptr);
+	floor->setTileCacheId(x, y, 0);
 
 	return tile;
 }
 
+// Same flags Tile::getBlocking reports once the template is turned into a tile
+static uint8_t getBasicTileBlocking(const BasicTilePtr &basicTile) {
+	if (!basicTile) {
+		return TILE_BLOCKING_PATH;
+	}
+
+	uint8_t blocking = basicTile->ground ? TILE_BLOCKING_NONE : TILE_BLOCKING_PATH;
+	const auto addItemBlocking = [&blocking](const BasicItemPtr &basicItem) {
+		const ItemType &itemType = Item::items[basicItem->id];
+		if (itemType.blockProjectile) {
+			blocking |= TILE_BLOCKING_PROJECTILE;
+		}
+		if (itemType.blockSolid) {
+			blocking |= TILE_BLOCKING_SOLID;
+		}
+		if (itemType.floorChange != 0 || itemType.isTeleport()) {
+			blocking |= TILE_BLOCKING_PATH;
+		}
+		if (itemType.isMagicField()) {
+			blocking |= TILE_BLOCKING_FIELD;
+		} else if (itemType.blockPathFind) {
+			blocking |= TILE_BLOCKING_MONSTER_PATH;
+		}
+	};
+
+	if (basicTile->flags & TILESTATE_PROTECTIONZONE) {
+		blocking |= TILE_BLOCKING_MONSTER_PATH;
+	}
+
+	if (basicTile->ground) {
+		addItemBlocking(basicTile->ground);
+	}
+	for (const auto &basicItem : basicTile->items) {
+		addItemBlocking(basicItem);
+	}
+	return blocking;
+}
+
 void MapCache::setBasicTile(uint16_t x, uint16_t y, uint8_t z, const BasicTilePtr &newTile) {
 	if (z >= MAP_MAX_LAYERS) {
 		g_logger().error("Attempt to set tile on invalid coordinate: {}", Position(x, y, z).toString());
 		return;
 	}
 
-	root.getBestLeaf(x, y, 15)->createFloor(z)->setTileCache(x, y, static_tryGetTileFromCache(newTile));
+	uint32_t cacheId = 0;
+	if (newTile) {
+		// Cells sharing a template share its id, tryReplaceTileFromCache already merged equal tiles
+		const auto [it, inserted] = basicTileIds.try_emplace(newTile.get(), static_cast<uint32_t>(basicTiles.size()));
+		if (inserted) {
+			basicTiles.push_back(newTile);
+		}
+		cacheId = it->second;
+	}
+
+	const auto &floor = root.getBestLeaf(x, y, 15)->createFloor(z);
+	floor->setTileCacheId(x, y, cacheId);
+	// A tile already created keeps answering for the position, see Map::getTile
+	if (!floor->getTile(x, y)) {
+		floor->setBlocking(x, y, getBasicTileBlocking(newTile));
+	}
+}
+
+size_t Floor::getTileCount() const {
+	if (!tiles) {
+		return 0;
+	}
+	return std::ranges::count_if(*tiles, [](const TilePtr &tile) { return tile != nullptr; });
+}
+
+size_t Floor::getCachedTileCount() const {
+	return std::ranges::count_if(cacheIds, [](uint32_t cacheId) { return cacheId != 0; });
+}
+
+size_t Floor::getMemoryUsage() const {
+	return sizeof(Floor) + (tiles ? sizeof(*tiles) : 0);
 }
 
 BasicItemPtr MapCache::tryReplaceItemFromCache(const BasicItemPtr &ref) {
 	return static_tryGetItemFromCache(ref);
 }
 
+BasicTilePtr MapCache::tryReplaceTileFromCache(const BasicTilePtr &ref) {
+	return static_tryGetTileFromCache(ref);
+}
+
 void BasicTile::hash(size_t &h) const {
 	const uint32_t arr[] = { flags, houseId, type, isStatic };
 	for (const auto v : arr) {
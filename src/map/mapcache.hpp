@@ -88,32 +88,93 @@ private:
 
 #pragma pack()
 
+// What a position of a Floor blocks, kept as one bitmap per flag so queries never create the tile
+enum TileBlocking_t : uint8_t {
+	TILE_BLOCKING_NONE = 0,
+	TILE_BLOCKING_PROJECTILE = 1 << 0,
+	TILE_BLOCKING_SOLID = 1 << 1,
+	// No creature can path into it: no ground, a floor change or a teleport
+	TILE_BLOCKING_PATH = 1 << 2,
+	TILE_BLOCKING_FIELD = 1 << 3,
+	// Monsters do not path into it: a protection zone or an item blocking path finding
+	TILE_BLOCKING_MONSTER_PATH = 1 << 4,
+
+	TILE_BLOCKING_COUNT = 5,
+};
+
+/**
+ * An 8x8 block of one floor. Loaded tiles are kept as ids of their shared
+ * BasicTile template until something asks for the tile, only then a Tile
+ * is created, so the untouched parts of the map cost four bytes per cell.
+ */
 struct Floor {
 	explicit Floor(uint8_t z) :
 		z(z) {};
 
 	Tile* getTile(uint16_t x, uint16_t y) const {
-		return tiles[x & FLOOR_MASK][y & FLOOR_MASK].first.get();
+		return tiles ? (*tiles)[getIndex(x, y)].get() : nullptr;
 	}
 
 	void setTile(uint16_t x, uint16_t y, Tile* tile) {
-		tiles[x & FLOOR_MASK][y & FLOOR_MASK].first.reset(tile);
+		if (!tiles) {
+			if (!tile) {
+				return;
+			}
+			tiles = std::make_unique<std::array<TilePtr, FLOOR_SIZE * FLOOR_SIZE>>();
+		}
+		(*tiles)[getIndex(x, y)].reset(tile);
 	}
 
-	BasicTilePtr getTileCache(uint16_t x, uint16_t y) const {
-		return tiles[x & FLOOR_MASK][y & FLOOR_MASK].second;
+	// Index of the cell's template in MapCache, 0 if there is none waiting to be turned into a tile
+	uint32_t getTileCacheId(uint16_t x, uint16_t y) const {
+		return cacheIds[getIndex(x, y)];
 	}
 
-	void setTileCache(uint16_t x, uint16_t y, const BasicTilePtr &newTile) {
-		tiles[x & FLOOR_MASK][y & FLOOR_MASK].second = newTile;
+	void setTileCacheId(uint16_t x, uint16_t y, uint32_t cacheId) {
+		cacheIds[getIndex(x, y)] = cacheId;
 	}
 
 	uint8_t getZ() const {
 		return z;
 	}
 
+	bool hasBlocking(uint16_t x, uint16_t y, TileBlocking_t blocking) const {
+		return (blockingMasks[std::countr_zero(static_cast<uint8_t>(blocking))] >> getIndex(x, y)) & 1;
+	}
+
+	uint8_t getBlocking(uint16_t x, uint16_t y) const {
+		uint8_t blocking = TILE_BLOCKING_NONE;
+		for (uint8_t i = 0; i < TILE_BLOCKING_COUNT; ++i) {
+			blocking |= ((blockingMasks[i] >> getIndex(x, y)) & 1) << i;
+		}
+		return blocking;
+	}
+
+	void setBlocking(uint16_t x, uint16_t y, uint8_t blocking) {
+		const uint64_t bit = uint64_t { 1 } << getIndex(x, y);
+		for (uint8_t i = 0; i < TILE_BLOCKING_COUNT; ++i) {
+			if ((blocking >> i) & 1) {
+				blockingMasks[i] |= bit;
+			} else {
+				blockingMasks[i] &= ~bit;
+			}
+		}
+	}
+
+	size_t getTileCount() const;
+	size_t getCachedTileCount() const;
+	size_t getMemoryUsage() const;
+
 private:
-	std::pair<TilePtr, BasicTilePtr> tiles[FLOOR_SIZE][FLOOR_SIZE] = {};
+	static size_t getIndex(uint16_t x, uint16_t y) {
+		return static_cast<size_t>(x & FLOOR_MASK) * FLOOR_SIZE + (y & FLOOR_MASK);
+	}
+
+	std::array<uint32_t, FLOOR_SIZE * FLOOR_SIZE> cacheIds {};
+	// Indexed by the bit of the TileBlocking_t flag, a position without tile has no ground to path into
+	std::array<uint64_t, TILE_BLOCKING_COUNT> blockingMasks { 0, 0, ~uint64_t { 0 }, 0, 0 };
+	// Allocated once the first tile of the block is created
+	std::unique_ptr<std::array<TilePtr, FLOOR_SIZE * FLOOR_SIZE>> tiles;
 	uint8_t z { 0 };
 };
 
@@ -121,18 +182,30 @@ class MapCache {
 public:
 	virtual ~MapCache() = default;
 
+	// Not thread safe, the tile should come from tryReplaceTileFromCache
 	void setBasicTile(uint16_t x, uint16_t y, uint8_t z, const BasicTilePtr &BasicTile);
 
+	// Both are thread safe
 	BasicItemPtr tryReplaceItemFromCache(const BasicItemPtr &ref);
+	BasicTilePtr tryReplaceTileFromCache(const BasicTilePtr &ref);
 
 	void flush();
 
 protected:
 	Tile* getOrCreateTileFromCache(const std::unique_ptr<Floor> &floor, uint16_t x, uint16_t y);
 
+	size_t getBasicTileCount() const {
+		return basicTiles.size() - 1;
+	}
+
 	QTreeNode root;
 
 private:
 	void parseItemAttr(const BasicItemPtr &BasicItem, Item* item);
 	Item* createItem(const BasicItemPtr &BasicItem, Position position);
+
+	// Templates referenced by the floors through their index, index 0 is no template
+	std::vector<BasicTilePtr> basicTiles { nullptr };
+	// Only needed while a map is being placed, cleared by flush
+	phmap::flat_hash_map<const BasicTile*, uint32_t> basicTileIds;
 };
@@ -13,71 +13,81 @@
 #include "creatures/monsters/monster.hpp"
 #include "creatures/combat/combat.hpp"
 
+AStarNodes::Arena &AStarNodes::getArena() {
+	static thread_local std::unique_ptr<Arena> arena = std::make_unique<Arena>();
+	return *arena;
+}
+
 AStarNodes::AStarNodes(uint32_t x, uint32_t y) :
-	nodes(), openNodes() {
+	arena(getArena()), nodes(arena.nodes), originX(x), originY(y) {
+	assert(!arena.inUse);
+	arena.inUse = true;
+
 	curNode = 1;
 	closedNodes = 0;
-	openNodes[0] = true;
+	heapSize = 0;
 
 	AStarNode &startNode = nodes[0];
 	startNode.parent = nullptr;
 	startNode.x = x;
 	startNode.y = y;
 	startNode.f = 0;
-	nodeTable[(x << 16) | y] = nodes;
+	arena.grid[getGridIndex(x, y)] = 1;
+	pushHeap(0);
+}
+
+AStarNodes::~AStarNodes() {
+	// Only the cells that got a node are dirty, reset them for the next search
+	for (size_t i = 0; i < curNode; ++i) {
+		arena.grid[getGridIndex(nodes[i].x, nodes[i].y)] = 0;
+	}
+	arena.inUse = false;
 }
 
 AStarNode* AStarNodes::createOpenNode(AStarNode* parent, uint32_t x, uint32_t y, int_fast32_t f) {
-	if (curNode >= MAX_NODES) {
+	if (curNode >= MAX_NODES || !isInSearchArea(x, y)) {
 		return nullptr;
 	}
 
-	size_t retNode = curNode++;
-	openNodes[retNode] = true;
+	const auto retNode = static_cast<uint16_t>(curNode++);
+	arena.grid[getGridIndex(x, y)] = retNode + 1;
 
 	AStarNode* node = nodes + retNode;
-	nodeTable[(x << 16) | y] = node;
 	node->parent = parent;
 	node->x = x;
 	node->y = y;
 	node->f = f;
+	pushHeap(retNode);
 	return node;
 }
 
 AStarNode* AStarNodes::getBestNode() {
-	if (curNode == 0) {
+	if (heapSize == 0) {
 		return nullptr;
 	}
-
-	int32_t best_node_f = std::numeric_limits<int32_t>::max();
-	int32_t best_node = -1;
-	for (size_t i = 0; i < curNode; i++) {
-		if (openNodes[i] && nodes[i].f < best_node_f) {
-			best_node_f = nodes[i].f;
-			best_node = i;
-		}
-	}
-
-	if (best_node >= 0) {
-		return nodes + best_node;
-	}
-	return nullptr;
+	return nodes + arena.heap[0];
 }
 
 void AStarNodes::closeNode(const AStarNode* node) {
 	size_t index = node - nodes;
 	assert(index < MAX_NODES);
-	openNodes[index] = false;
+	if (arena.heapPosition[index] != NOT_IN_HEAP) {
+		removeHeap(arena.heapPosition[index]);
+	}
 	++closedNodes;
 }
 
 void AStarNodes::openNode(const AStarNode* node) {
 	size_t index = node - nodes;
 	assert(index < MAX_NODES);
-	if (!openNodes[index]) {
-		openNodes[index] = true;
-		--closedNodes;
+	if (arena.heapPosition[index] != NOT_IN_HEAP) {
+		// Already open, its f was lowered by the caller
+		siftUp(arena.heapPosition[index]);
+		return;
 	}
+
+	pushHeap(static_cast<uint16_t>(index));
+	--closedNodes;
 }
 
 int_fast32_t AStarNodes::getClosedNodes() const {
@@ -85,11 +95,72 @@ int_fast32_t AStarNodes::getClosedNodes() const {
 }
 
 AStarNode* AStarNodes::getNodeByPosition(uint32_t x, uint32_t y) {
-	auto it = nodeTable.find((x << 16) | y);
-	if (it == nodeTable.end()) {
+	if (!isInSearchArea(x, y)) {
 		return nullptr;
 	}
-	return it->second;
+
+	const uint16_t index = arena.grid[getGridIndex(x, y)];
+	return index != 0 ? nodes + (index - 1) : nullptr;
+}
+
+void AStarNodes::pushHeap(uint16_t index) {
+	const int16_t position = heapSize++;
+	arena.heap[position] = index;
+	arena.heapPosition[index] = position;
+	siftUp(position);
+}
+
+void AStarNodes::removeHeap(int16_t position) {
+	const int16_t last = --heapSize;
+	arena.heapPosition[arena.heap[position]] = NOT_IN_HEAP;
+	if (position == last) {
+		return;
+	}
+
+	arena.heap[position] = arena.heap[last];
+	arena.heapPosition[arena.heap[position]] = position;
+	siftDown(position);
+	siftUp(position);
+}
+
+void AStarNodes::siftUp(int16_t position) {
+	while (position > 0) {
+		const int16_t parent = (position - 1) / 2;
+		if (nodes[arena.heap[parent]].f <= nodes[arena.heap[position]].f) {
+			break;
+		}
+
+		swapHeap(position, parent);
+		position = parent;
+	}
+}
+
+void AStarNodes::siftDown(int16_t position) {
+	while (true) {
+		const int16_t left = position * 2 + 1;
+		if (left >= heapSize) {
+			break;
+		}
+
+		const int16_t right = left + 1;
+		int16_t smallest = left;
+		if (right < heapSize && nodes[arena.heap[right]].f < nodes[arena.heap[left]].f) {
+			smallest = right;
+		}
+
+		if (nodes[arena.heap[position]].f <= nodes[arena.heap[smallest]].f) {
+			break;
+		}
+
+		swapHeap(position, smallest);
+		position = smallest;
+	}
+}
+
+void AStarNodes::swapHeap(int16_t first, int16_t second) {
+	std::swap(arena.heap[first], arena.heap[second]);
+	arena.heapPosition[arena.heap[first]] = first;
+	arena.heapPosition[arena.heap[second]] = second;
 }
 
 int_fast32_t AStarNodes::getMapWalkCost(AStarNode* node, const Position &neighborPos, bool preferDiagonal) {
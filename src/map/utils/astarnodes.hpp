@@ -9,6 +9,8 @@
 
 #pragma once
 
+#include "map/map_const.hpp"
+
 class Position;
 class Creature;
 class Tile;
@@ -19,9 +21,19 @@ struct AStarNode {
 	uint16_t x, y;
 };
 
+/**
+ * Node storage for a single path search. The nodes, the open list heap and the
+ * position grid live in a thread local arena that is reused by every search,
+ * so a search never allocates. Only one search may be active per thread.
+ */
 class AStarNodes {
 public:
 	AStarNodes(uint32_t x, uint32_t y);
+	~AStarNodes();
+
+	// non-copyable
+	AStarNodes(const AStarNodes &) = delete;
+	AStarNodes &operator=(const AStarNodes &) = delete;
 
 	AStarNode* createOpenNode(AStarNode* parent, uint32_t x, uint32_t y, int_fast32_t f);
 	AStarNode* getBestNode();
@@ -30,18 +42,51 @@ public:
 	int_fast32_t getClosedNodes() const;
 	AStarNode* getNodeByPosition(uint32_t x, uint32_t y);
 
+	/**
+	 * Positions further than this from the start are outside of the node grid and cannot be searched.
+	 * The node limit already keeps real searches well inside it.
+	 */
+	bool isInSearchArea(uint32_t x, uint32_t y) const {
+		return (x - originX + GRID_RADIUS) < GRID_SIZE && (y - originY + GRID_RADIUS) < GRID_SIZE;
+	}
+
 	static int_fast32_t getMapWalkCost(AStarNode* node, const Position &neighborPos, bool preferDiagonal = false);
 	static int_fast32_t getTileWalkCost(const Creature &creature, const Tile* tile);
 
 private:
 	static constexpr int32_t MAX_NODES = 512;
-	static constexpr int32_t MAP_NORMALWALKCOST = 10;
-	static constexpr int32_t MAP_PREFERDIAGONALWALKCOST = 14;
-	static constexpr int32_t MAP_DIAGONALWALKCOST = 25;
 
-	AStarNode nodes[MAX_NODES];
-	bool openNodes[MAX_NODES];
-	phmap::flat_hash_map<uint32_t, AStarNode*> nodeTable;
+	static constexpr uint32_t GRID_RADIUS = 127;
+	static constexpr uint32_t GRID_SIZE = GRID_RADIUS * 2 + 1;
+	static constexpr int16_t NOT_IN_HEAP = -1;
+
+	struct Arena {
+		AStarNode nodes[MAX_NODES];
+		// Open list as a binary min-heap of node indexes ordered by f
+		uint16_t heap[MAX_NODES];
+		int16_t heapPosition[MAX_NODES];
+		// Node index + 1 for every position around the start, 0 means no node
+		uint16_t grid[GRID_SIZE * GRID_SIZE];
+		bool inUse = false;
+	};
+
+	static Arena &getArena();
+
+	uint32_t getGridIndex(uint32_t x, uint32_t y) const {
+		return (y - originY + GRID_RADIUS) * GRID_SIZE + (x - originX + GRID_RADIUS);
+	}
+
+	void pushHeap(uint16_t index);
+	void removeHeap(int16_t position);
+	void siftUp(int16_t position);
+	void siftDown(int16_t position);
+	void swapHeap(int16_t first, int16_t second);
+
+	Arena &arena;
+	AStarNode* nodes;
+	uint32_t originX;
+	uint32_t originY;
 	size_t curNode;
+	int16_t heapSize;
 	int_fast32_t closedNodes;
 };
@@ -0,0 +1,90 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2023 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "pch.hpp"
+
+#include "flowfield.hpp"
+#include "map/map.hpp"
+
+void FlowField::build(Map &map, const Position &newTargetPos) {
+	// Read from the floor bitmaps, so tiles still in the map cache are not created to be looked at.
+	// Walkability is looked up once per tile, the search may visit a tile up to eight times
+	static constexpr uint8_t blocking = TILE_BLOCKING_SOLID | TILE_BLOCKING_PATH | TILE_BLOCKING_MONSTER_PATH;
+	TileBlockingReader reader(map, newTargetPos.z);
+	WalkableGrid walkable;
+	size_t cell = 0;
+	for (int_fast32_t dy = -FLOW_FIELD_RADIUS; dy <= FLOW_FIELD_RADIUS; ++dy) {
+		for (int_fast32_t dx = -FLOW_FIELD_RADIUS; dx <= FLOW_FIELD_RADIUS; ++dx) {
+			const int_fast32_t x = newTargetPos.x + dx;
+			const int_fast32_t y = newTargetPos.y + dy;
+			const bool insideMap = x >= 0 && y >= 0 && x <= std::numeric_limits<uint16_t>::max() && y <= std::numeric_limits<uint16_t>::max();
+			walkable[cell++] = insideMap && (reader.get(static_cast<uint16_t>(x), static_cast<uint16_t>(y)) & blocking) == 0;
+		}
+	}
+	build(newTargetPos, walkable);
+}
+
+void FlowField::build(const Position &newTargetPos, WalkableGrid walkable) {
+	static constexpr int_fast32_t neighbors[8][3] = {
+		{ -1, 0, MAP_NORMALWALKCOST },
+		{ 0, 1, MAP_NORMALWALKCOST },
+		{ 1, 0, MAP_NORMALWALKCOST },
+		{ 0, -1, MAP_NORMALWALKCOST },
+		{ -1, -1, MAP_DIAGONALWALKCOST },
+		{ 1, -1, MAP_DIAGONALWALKCOST },
+		{ 1, 1, MAP_DIAGONALWALKCOST },
+		{ -1, 1, MAP_DIAGONALWALKCOST }
+	};
+
+	targetPos = newTargetPos;
+	built = true;
+	costs.fill(UNREACHABLE);
+
+	// The target tile itself is never a destination, followers stop next to it
+	const size_t center = FLOW_FIELD_RADIUS * FLOW_FIELD_SIZE + FLOW_FIELD_RADIUS;
+	walkable[center] = false;
+
+	using QueueEntry = std::pair<uint16_t, uint16_t>; // cost, index
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<>> queue;
+	for (const auto &[dx, dy, stepCost] : neighbors) {
+		const size_t goalIndex = center + dy * FLOW_FIELD_SIZE + dx;
+		if (walkable[goalIndex]) {
+			costs[goalIndex] = 0;
+			queue.emplace(0, goalIndex);
+		}
+	}
+
+	while (!queue.empty()) {
+		const auto [cost, index] = queue.top();
+		queue.pop();
+		if (cost != costs[index]) {
+			// Stale entry, the tile was reached through a cheaper path meanwhile
+			continue;
+		}
+
+		const int_fast32_t x = index % FLOW_FIELD_SIZE;
+		const int_fast32_t y = index / FLOW_FIELD_SIZE;
+		for (const auto &[dx, dy, stepCost] : neighbors) {
+			const int_fast32_t nx = x + dx;
+			const int_fast32_t ny = y + dy;
+			if (nx < 0 || ny < 0 || nx >= FLOW_FIELD_SIZE || ny >= FLOW_FIELD_SIZE) {
+				continue;
+			}
+
+			const size_t neighborIndex = ny * FLOW_FIELD_SIZE + nx;
+			const auto newCost = static_cast<uint16_t>(cost + stepCost);
+			if (!walkable[neighborIndex] || costs[neighborIndex] <= newCost) {
+				continue;
+			}
+
+			costs[neighborIndex] = newCost;
+			queue.emplace(newCost, neighborIndex);
+		}
+	}
+}
@@ -0,0 +1,104 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2023 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include "game/movement/position.hpp"
+#include "map/map_const.hpp"
+
+class Map;
+
+/**
+ * Walk cost towards the tiles next to a target, for every tile within
+ * FLOW_FIELD_RADIUS of it. Built once per target position and shared by
+ * every creature that follows that target, instead of each one running A*.
+ * Only static walkability is stored here, creatures and fields on the way
+ * are checked by the follower when it reads its steps.
+ */
+class FlowField {
+public:
+	static constexpr int32_t FLOW_FIELD_RADIUS = 12;
+	static constexpr int32_t FLOW_FIELD_SIZE = FLOW_FIELD_RADIUS * 2 + 1;
+	static constexpr uint16_t UNREACHABLE = std::numeric_limits<uint16_t>::max();
+
+	// Indexed row by row from the top left corner of the field
+	using WalkableGrid = std::array<bool, FLOW_FIELD_SIZE * FLOW_FIELD_SIZE>;
+
+	static bool isInRange(const Position &targetPos, const Position &pos) {
+		return pos.z == targetPos.z && Position::getDistanceX(targetPos, pos) <= FLOW_FIELD_RADIUS && Position::getDistanceY(targetPos, pos) <= FLOW_FIELD_RADIUS;
+	}
+
+	void build(Map &map, const Position &newTargetPos);
+	/**
+	 * Builds the field from walkability already read around newTargetPos.
+	 */
+	void build(const Position &newTargetPos, WalkableGrid walkable);
+
+	bool isBuiltFor(const Position &pos) const {
+		return built && targetPos == pos;
+	}
+
+	const Position &getTargetPosition() const {
+		return targetPos;
+	}
+
+	/**
+	 * \returns The walk cost from pos to the nearest tile next to the target,
+	 * or UNREACHABLE if pos is out of range or no path is known.
+	 */
+	uint16_t getCost(const Position &pos) const {
+		if (!isInRange(targetPos, pos)) {
+			return UNREACHABLE;
+		}
+		return costs[getIndex(pos.x, pos.y)];
+	}
+
+	/**
+	 * The cheapest step down the field from pos that canWalkTo(position) allows,
+	 * straight steps first so equal costs keep the same preference as the A* search.
+	 * \returns DIRECTION_NONE if no step lowers the cost, nextPos is then left untouched.
+	 */
+	template <typename CanWalkTo>
+	Direction getNextStep(const Position &pos, CanWalkTo &&canWalkTo, Position &nextPos) const {
+		static constexpr std::array<std::pair<Direction, std::array<int_fast32_t, 2>>, 8> steps = { {
+			{ DIRECTION_WEST, { -1, 0 } },
+			{ DIRECTION_SOUTH, { 0, 1 } },
+			{ DIRECTION_EAST, { 1, 0 } },
+			{ DIRECTION_NORTH, { 0, -1 } },
+			{ DIRECTION_NORTHWEST, { -1, -1 } },
+			{ DIRECTION_NORTHEAST, { 1, -1 } },
+			{ DIRECTION_SOUTHEAST, { 1, 1 } },
+			{ DIRECTION_SOUTHWEST, { -1, 1 } },
+		} };
+
+		Direction bestDir = DIRECTION_NONE;
+		uint16_t bestCost = getCost(pos);
+		for (const auto &[dir, offset] : steps) {
+			const Position stepPos(pos.x + offset[0], pos.y + offset[1], pos.z);
+			const uint16_t stepCost = getCost(stepPos);
+			if (stepCost >= bestCost || !canWalkTo(stepPos)) {
+				continue;
+			}
+
+			bestDir = dir;
+			bestCost = stepCost;
+			nextPos = stepPos;
+		}
+		return bestDir;
+	}
+
+private:
+	size_t getIndex(uint16_t x, uint16_t y) const {
+		return static_cast<size_t>(y - targetPos.y + FLOW_FIELD_RADIUS) * FLOW_FIELD_SIZE + (x - targetPos.x + FLOW_FIELD_RADIUS);
+	}
+
+	std::array<uint16_t, FLOW_FIELD_SIZE * FLOW_FIELD_SIZE> costs {};
+	Position targetPos;
+	bool built = false;
+};
@@ -69,6 +69,19 @@ QTreeLeafNode* QTreeNode::getBestLeaf(uint32_t x, uint32_t y, uint32_t level) {
 	return leaf;
 }
 
+void QTreeNode::forEachLeaf(const std::function<void(const QTreeLeafNode &)> &callback) const {
+	if (leaf) {
+		callback(static_cast<const QTreeLeafNode &>(*this));
+		return;
+	}
+
+	for (const auto* node : child) {
+		if (node) {
+			node->forEachLeaf(callback);
+		}
+	}
+}
+
 void QTreeLeafNode::addCreature(Creature* c) {
 	creature_list.push_back(c);
 
@@ -52,6 +52,8 @@ public:
 
 	QTreeLeafNode* createLeaf(uint32_t x, uint32_t y, uint32_t level);
 
+	void forEachLeaf(const std::function<void(const QTreeLeafNode &)> &callback) const;
+
 protected:
 	QTreeNode* child[4] = {};
 	bool leaf = false;
@@ -80,6 +82,9 @@ public:
 	void removeCreature(Creature* c);
 
 private:
+	// Spectator queries centered in this sector, see Map::getSpectators
+	phmap::flat_hash_map<uint64_t, phmap::flat_hash_set<Creature*>> spectatorCache;
+
 	static bool newLeaf;
 	QTreeLeafNode* leafS = nullptr;
 	QTreeLeafNode* leafE = nullptr;
@@ -0,0 +1,44 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2023 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#include "pch.hpp"
+
+#include "sightmask.hpp"
+#include "map/map.hpp"
+
+void SightMask::build(Map &map, const Position &topLeft, uint16_t newWidth, uint16_t newHeight) {
+	origin = topLeft;
+	width = newWidth;
+	height = newHeight;
+	blocking.assign(static_cast<size_t>(width) * height, false);
+
+	TileBlockingReader blockingReader(map, origin.z);
+	size_t cell = 0;
+	for (uint16_t dy = 0; dy < height; ++dy) {
+		for (uint16_t dx = 0; dx < width; ++dx) {
+			blocking[cell++] = blockingReader.has(origin.x + dx, origin.y + dy, TILE_BLOCKING_PROJECTILE);
+		}
+	}
+}
+
+bool SightMask::checkSightLine(const Position &fromPos, const Position &toPos) const {
+	Position start(fromPos);
+	return walkLine(start, toPos, [this](uint16_t x, uint16_t y) {
+		return isBlocking(x, y);
+	});
+}
+
+bool SightMask::isSightClear(const Position &fromPos, const Position &toPos) const {
+	if (fromPos == toPos) {
+		return true;
+	}
+
+	// Same two converging rays as Map::isSightClear
+	return checkSightLine(fromPos, toPos) || checkSightLine(toPos, fromPos);
+}
@@ -0,0 +1,86 @@
+/**
+ * Canary - A free and open-source MMORPG server emulator
+ * Copyright (©) 2019-2023 OpenTibiaBR <opentibiabr@outlook.com>
+ * Repository: https://github.com/opentibiabr/canary
+ * License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+ * Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+ * Website: https://docs.opentibiabr.com/
+ */
+
+#pragma once
+
+#include "game/movement/position.hpp"
+
+class Map;
+
+/**
+ * The projectile blocking tiles of a rectangle of one floor, read from the
+ * floor bitmaps in a single pass. Sight lines between positions inside the
+ * rectangle are then walked over the mask, with the same answer
+ * Map::isSightClear gives on that floor, without a map lookup per step.
+ */
+class SightMask {
+public:
+	/**
+	 * Walks the sight line from start towards destination on start's floor,
+	 * leaving start at the destination's x and y if nothing blocks it.
+	 * The start position itself is never tested.
+	 * \returns false at the first position isBlocking(x, y) is true for.
+	 */
+	template <typename IsBlocking>
+	static bool walkLine(Position &start, const Position &destination, IsBlocking &&isBlocking) {
+		const int8_t mx = start.x < destination.x ? 1 : start.x == destination.x ? 0
+																				 : -1;
+		const int8_t my = start.y < destination.y ? 1 : start.y == destination.y ? 0
+																				 : -1;
+
+		int32_t A = Position::getOffsetY(destination, start);
+		int32_t B = Position::getOffsetX(start, destination);
+		int32_t C = -(A * destination.x + B * destination.y);
+
+		while (start.x != destination.x || start.y != destination.y) {
+			int32_t move_hor = std::abs(A * (start.x + mx) + B * (start.y) + C);
+			int32_t move_ver = std::abs(A * (start.x) + B * (start.y + my) + C);
+			int32_t move_cross = std::abs(A * (start.x + mx) + B * (start.y + my) + C);
+
+			if (start.y != destination.y && (start.x == destination.x || move_hor > move_ver || move_hor > move_cross)) {
+				start.y += my;
+			}
+
+			if (start.x != destination.x && (start.y == destination.y || move_ver > move_hor || move_ver > move_cross)) {
+				start.x += mx;
+			}
+
+			if (isBlocking(start.x, start.y)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/**
+	 * Reads the rectangle of width x height positions whose top left corner is topLeft.
+	 */
+	void build(Map &map, const Position &topLeft, uint16_t newWidth, uint16_t newHeight);
+
+	bool contains(const Position &pos) const {
+		return pos.z == origin.z && pos.x >= origin.x && pos.y >= origin.y && pos.x - origin.x < width && pos.y - origin.y < height;
+	}
+
+	/**
+	 * Both positions must be inside the rectangle.
+	 */
+	bool isSightClear(const Position &fromPos, const Position &toPos) const;
+
+private:
+	bool checkSightLine(const Position &fromPos, const Position &toPos) const;
+
+	bool isBlocking(uint16_t x, uint16_t y) const {
+		return blocking[static_cast<size_t>(y - origin.y) * width + (x - origin.x)];
+	}
+
+	std::vector<bool> blocking;
+	Position origin;
+	uint16_t width = 0;
+	uint16_t height = 0;
+};
@@ -21,18 +21,23 @@
 // STL Includes
 // --------------------
 
+#include <bit>
 #include <bitset>
 #include <charconv>
+#include <condition_variable>
 #include <filesystem>
 #include <fstream>
 #include <forward_list>
+#include <latch>
 #include <list>
 #include <map>
+#include <numeric>
 #include <queue>
 #include <random>
 #include <ranges>
 #include <regex>
 #include <set>
+#include <span>
 #include <thread>
 #include <vector>
 #include <variant>
@@ -58,6 +63,7 @@
 // --------------------
 
 // ABSL
+#include <absl/container/inlined_vector.h>
 #include <absl/numeric/int128.h>
 
 // ARGON2
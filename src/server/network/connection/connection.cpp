@@ -70,7 +70,7 @@ void Connection::close(bool force) {
 		g_dispatcher().addTask(std::bind_front(&Protocol::release, protocol), 1000);
 	}
 
-	if (messageQueue.empty() || force) {
+	if (!writeInProgress || force) {
 		closeSocket();
 	} else {
 		// will be closed by the destructor or onWriteOperation
@@ -298,15 +298,16 @@ void Connection::send(const OutputMessage_ptr &outputMessage) {
 		return;
 	}
 
-	bool noPendingWrite = messageQueue.empty();
 	messageQueue.emplace_back(outputMessage);
-	if (noPendingWrite) {
+	if (!writeInProgress) {
+		writeInProgress = true;
 		// Make asio thread handle xtea encryption instead of dispatcher
 		try {
 			asio::post(socket.get_executor(), std::bind(&Connection::internalWorker, shared_from_this()));
 		} catch (const std::system_error &e) {
 			g_logger().error("[Connection::send] - error: {}", e.what());
 			messageQueue.clear();
+			writeInProgress = false;
 			close(FORCE_CLOSE);
 		}
 	}
@@ -315,14 +316,29 @@ void Connection::send(const OutputMessage_ptr &outputMessage) {
 void Connection::internalWorker() {
 	std::unique_lock<std::recursive_mutex> lockClass(connectionLock);
 	if (!messageQueue.empty()) {
-		const OutputMessage_ptr &outputMessage = messageQueue.front();
-		lockClass.unlock();
+		prepareWriteBatch(lockClass);
+		internalSend();
+	} else {
+		writeInProgress = false;
+		if (connectionState == CONNECTION_STATE_CLOSED) {
+			closeSocket();
+		}
+	}
+}
+
+void Connection::prepareWriteBatch(std::unique_lock<std::recursive_mutex> &lockClass) {
+	// Take every queued message at once, senders only wait for the swap
+	writeQueue.swap(messageQueue);
+	lockClass.unlock();
+
+	writeBuffers.clear();
+	writeBuffers.reserve(writeQueue.size());
+	for (const OutputMessage_ptr &outputMessage : writeQueue) {
 		protocol->onSendMessage(outputMessage);
-		lockClass.lock();
-		internalSend(outputMessage);
-	} else if (connectionState == CONNECTION_STATE_CLOSED) {
-		closeSocket();
+		writeBuffers.emplace_back(outputMessage->getOutputBuffer(), outputMessage->getLength());
 	}
+
+	lockClass.lock();
 }
 
 uint32_t Connection::getIP() {
@@ -338,12 +354,13 @@ uint32_t Connection::getIP() {
 	return htonl(endpoint.address().to_v4().to_ulong());
 }
 
-void Connection::internalSend(const OutputMessage_ptr &outputMessage) {
+void Connection::internalSend() {
 	try {
 		writeTimer.expires_from_now(std::chrono::seconds(CONNECTION_WRITE_TIMEOUT));
 		writeTimer.async_wait(std::bind(&Connection::handleTimeout, std::weak_ptr<Connection>(shared_from_this()), std::placeholders::_1));
 
-		asio::async_write(socket, asio::buffer(outputMessage->getOutputBuffer(), outputMessage->getLength()), std::bind(&Connection::onWriteOperation, shared_from_this(), std::placeholders::_1));
+		// A single gathered write for the whole batch
+		asio::async_write(socket, writeBuffers, std::bind(&Connection::onWriteOperation, shared_from_this(), std::placeholders::_1));
 	} catch (const std::system_error &e) {
 		g_logger().error("[Connection::internalSend] - error: {}", e.what());
 	}
@@ -352,22 +369,25 @@ void Connection::internalSend(const OutputMessage_ptr &outputMessage) {
 void Connection::onWriteOperation(const std::error_code &error) {
 	std::unique_lock<std::recursive_mutex> lockClass(connectionLock);
 	writeTimer.cancel();
-	messageQueue.pop_front();
+	// Releasing the written messages hands their buffers back to the output message pool
+	writeQueue.clear();
+	writeBuffers.clear();
 
 	if (error) {
 		messageQueue.clear();
+		writeInProgress = false;
 		close(FORCE_CLOSE);
 		return;
 	}
 
 	if (!messageQueue.empty()) {
-		const OutputMessage_ptr &outputMessage = messageQueue.front();
-		lockClass.unlock();
-		protocol->onSendMessage(outputMessage);
-		lockClass.lock();
-		internalSend(outputMessage);
-	} else if (connectionState == CONNECTION_STATE_CLOSED) {
-		closeSocket();
+		prepareWriteBatch(lockClass);
+		internalSend();
+	} else {
+		writeInProgress = false;
+		if (connectionState == CONNECTION_STATE_CLOSED) {
+			closeSocket();
+		}
 	}
 }
 
@@ -79,7 +79,8 @@ private:
 
 	void closeSocket();
 	void internalWorker();
-	void internalSend(const OutputMessage_ptr &outputMessage);
+	void prepareWriteBatch(std::unique_lock<std::recursive_mutex> &lockClass);
+	void internalSend();
 
 	asio::ip::tcp::socket &getSocket() {
 		return socket;
@@ -92,7 +93,11 @@ private:
 
 	std::recursive_mutex connectionLock;
 
-	std::list<OutputMessage_ptr> messageQueue;
+	// Messages waiting for the next write, filled by any thread
+	std::vector<OutputMessage_ptr> messageQueue;
+	// Messages of the write in progress and their buffers, only touched by the writing asio handler
+	std::vector<OutputMessage_ptr> writeQueue;
+	std::vector<asio::const_buffer> writeBuffers;
 
 	ConstServicePort_ptr service_port;
 	Protocol_ptr protocol;
@@ -104,6 +109,7 @@ private:
 
 	std::underlying_type_t<ConnectionState_t> connectionState = CONNECTION_STATE_OPEN;
 	bool receivedFirst = false;
+	bool writeInProgress = false;
 
 	friend class ServicePort;
 	friend class ConnectionManager;
@@ -52,5 +52,108 @@ void OutputMessagePool::removeProtocolFromAutosend(const Protocol_ptr &protocol)
 }
 
 OutputMessage_ptr OutputMessagePool::getOutputMessage() {
-	return std::make_shared<OutputMessage>();
+	// The block goes back to the pool once the last reference is gone, usually when the connection finished writing it
+	return std::allocate_shared<OutputMessage>(OutputMessageAllocator<OutputMessage>());
+}
+
+namespace {
+	struct FreeBlock {
+		FreeBlock* next;
+	};
+
+	std::atomic<FreeBlock*> globalFreeList { nullptr };
+	std::atomic<uint64_t> poolHits { 0 };
+	std::atomic<uint64_t> poolMisses { 0 };
+	std::atomic<int64_t> blocksInUse { 0 };
+	std::atomic<int64_t> highWaterMark { 0 };
+
+	void pushGlobal(FreeBlock* first, FreeBlock* last) {
+		FreeBlock* head = globalFreeList.load(std::memory_order_relaxed);
+		do {
+			last->next = head;
+		} while (!globalFreeList.compare_exchange_weak(head, first, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	struct LocalCache {
+		FreeBlock* head = nullptr;
+		size_t size = 0;
+
+		~LocalCache() {
+			// Hand the blocks of an exiting thread over to the others
+			if (!head) {
+				return;
+			}
+
+			FreeBlock* last = head;
+			while (last->next) {
+				last = last->next;
+			}
+			pushGlobal(head, last);
+		}
+	};
+
+	thread_local LocalCache localCache;
+}
+
+void* OutputMessageBlockPool::allocate() {
+	LocalCache &cache = localCache;
+	if (!cache.head) {
+		// Only whole lists are ever popped from the global list, so there is no ABA problem
+		cache.head = globalFreeList.exchange(nullptr, std::memory_order_acquire);
+		for (const FreeBlock* block = cache.head; block; block = block->next) {
+			++cache.size;
+		}
+	}
+
+	void* block = cache.head;
+	if (block) {
+		cache.head = cache.head->next;
+		--cache.size;
+		poolHits.fetch_add(1, std::memory_order_relaxed);
+	} else {
+		block = ::operator new(BLOCK_SIZE);
+		poolMisses.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	const int64_t inUse = blocksInUse.fetch_add(1, std::memory_order_relaxed) + 1;
+	int64_t highest = highWaterMark.load(std::memory_order_relaxed);
+	while (inUse > highest && !highWaterMark.compare_exchange_weak(highest, inUse, std::memory_order_relaxed)) { }
+	return block;
+}
+
+void OutputMessageBlockPool::deallocate(void* block) noexcept {
+	blocksInUse.fetch_sub(1, std::memory_order_relaxed);
+
+	auto freeBlock = new (block) FreeBlock { nullptr };
+	LocalCache &cache = localCache;
+	if (cache.size < LOCAL_CACHE_SIZE) {
+		freeBlock->next = cache.head;
+		cache.head = freeBlock;
+		++cache.size;
+		return;
+	}
+	pushGlobal(freeBlock, freeBlock);
+}
+
+uint64_t OutputMessageBlockPool::getHits() {
+	return poolHits.load(std::memory_order_relaxed);
+}
+
+uint64_t OutputMessageBlockPool::getMisses() {
+	return poolMisses.load(std::memory_order_relaxed);
+}
+
+int64_t OutputMessageBlockPool::getBlocksInUse() {
+	return blocksInUse.load(std::memory_order_relaxed);
+}
+
+int64_t OutputMessageBlockPool::getHighWaterMark() {
+	return highWaterMark.load(std::memory_order_relaxed);
+}
+
+void OutputMessageBlockPool::logStats() {
+	const uint64_t hits = getHits();
+	const uint64_t misses = getMisses();
+	const uint64_t total = hits + misses;
+	g_logger().info("Output message pool: {} allocations, {:.1f}% recycled, {} from the heap, {} blocks in use (peak {})", total, total == 0 ? 0.0 : hits * 100.0 / total, misses, getBlocksInUse(), getHighWaterMark());
 }
@@ -17,7 +17,8 @@ class Protocol;
 
 class OutputMessage : public NetworkMessage {
 public:
-	OutputMessage() = default;
+	// User provided on purpose, a defaulted constructor would get the whole buffer zeroed on value initialization
+	OutputMessage() { }
 
 	// non-copyable
 	OutputMessage(const OutputMessage &) = delete;
@@ -66,6 +67,68 @@ private:
 	MsgSize_t outputBufferStart = INITIAL_BUFFER_POSITION;
 };
 
+/**
+ * Fixed size memory blocks for output messages, together with their shared_ptr control block.
+ * Released blocks are kept in a small per thread cache, the overflow goes to a global lock-free list
+ * that a thread running out of blocks takes over as a whole.
+ */
+class OutputMessageBlockPool {
+public:
+	static constexpr size_t BLOCK_SIZE = sizeof(OutputMessage) + 64;
+	static constexpr size_t LOCAL_CACHE_SIZE = 32;
+
+	static void* allocate();
+	static void deallocate(void* block) noexcept;
+
+	// Allocations served by a recycled block
+	static uint64_t getHits();
+	// Allocations that had to go to the heap
+	static uint64_t getMisses();
+	static int64_t getBlocksInUse();
+	// Highest number of blocks in use at the same time
+	static int64_t getHighWaterMark();
+	/**
+	 * Logs the counters above, LOCAL_CACHE_SIZE is worth raising when misses
+	 * keep growing past the high water mark.
+	 */
+	static void logStats();
+};
+
+template <typename T>
+class OutputMessageAllocator {
+public:
+	using value_type = T;
+
+	OutputMessageAllocator() = default;
+	template <typename U>
+	OutputMessageAllocator(const OutputMessageAllocator<U> &) noexcept { }
+
+	T* allocate(size_t n) {
+		if (usesPool(n)) {
+			return static_cast<T*>(OutputMessageBlockPool::allocate());
+		}
+		return std::allocator<T>().allocate(n);
+	}
+
+	void deallocate(T* p, size_t n) noexcept {
+		if (usesPool(n)) {
+			OutputMessageBlockPool::deallocate(p);
+			return;
+		}
+		std::allocator<T>().deallocate(p, n);
+	}
+
+	template <typename U>
+	bool operator==(const OutputMessageAllocator<U> &) const noexcept {
+		return true;
+	}
+
+private:
+	static constexpr bool usesPool(size_t n) {
+		return n == 1 && sizeof(T) <= OutputMessageBlockPool::BLOCK_SIZE && alignof(T) <= alignof(std::max_align_t);
+	}
+};
+
 class OutputMessagePool {
 public:
 	OutputMessagePool() = default;
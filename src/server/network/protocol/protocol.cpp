@@ -50,15 +50,14 @@ bool Protocol::sendRecvMessageCallback(NetworkMessage &msg) {
 	}
 
 	auto protocolWeak = std::weak_ptr<Protocol>(shared_from_this());
-	std::function<void(void)> callback = [protocolWeak, &msg]() {
+	g_dispatcher().addTask([protocolWeak, &msg]() {
 		if (auto protocol = protocolWeak.lock()) {
 			if (auto protocolConnection = protocol->getConnection()) {
 				protocol->parsePacket(msg);
 				protocolConnection->resumeWork();
 			}
 		}
-	};
-	g_dispatcher().addTask(callback);
+	});
 	return true;
 }
 
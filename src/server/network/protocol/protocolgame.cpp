@@ -29,6 +29,7 @@
 #include "server/network/protocol/protocolgame.hpp"
 #include "game/scheduling/dispatcher.hpp"
 #include "game/scheduling/scheduler.hpp"
+#include "lib/thread/thread_pool.hpp"
 #include "creatures/combat/spells.hpp"
 #include "creatures/players/management/waitlist.hpp"
 #include "items/weapons/weapons.hpp"
@@ -528,27 +529,19 @@ void ProtocolGame::login(const std::string &name, uint32_t accountId, OperatingS
 			return;
 		}
 
-		if (!IOLoginData::loadPlayerById(player, player->getGUID(), false)) {
-			g_game().removePlayerUniqueLogin(player);
-			disconnectClient("Your character could not be loaded.");
-			g_logger().warn("Player {} could not be loaded", player->getName());
-			return;
-		}
-
-		player->setOperatingSystem(operatingSystem);
-
-		if (!g_game().placeCreature(player, player->getLoginPosition()) && !g_game().placeCreature(player, player->getTemplePosition(), false, true)) {
-			g_game().removePlayerUniqueLogin(player);
-			disconnectClient("Temple position is wrong. Please, contact the administrator.");
-			g_logger().warn("Player {} temple position is wrong", player->getName());
-			return;
-		}
-
-		player->lastIP = player->getIP();
-		player->lastLoginSaved = std::max<time_t>(time(nullptr), player->lastLoginSaved + 1);
-		acceptPackets = true;
+		// The character's rows are fetched on the thread pool, the player is then built on the dispatcher
+		auto prefetched = std::make_shared<DBPrefetchedResults>();
+		const uint32_t guid = player->getGUID();
+		const uint32_t playerAccountId = player->getAccount();
+		player->isLoading = true;
+		player->incrementReferenceCounter();
+		inject<ThreadPool>().addLoad([self = getThis(), loadingPlayer = player, prefetched, guid, playerAccountId, operatingSystem] {
+			IOLoginData::prefetchPlayer(*prefetched, guid, playerAccountId);
+			g_dispatcher().addTask(std::bind(&ProtocolGame::finishLogin, self, loadingPlayer, prefetched, operatingSystem));
+		});
+		return;
 	} else {
-		if (eventConnect != 0 || !g_configManager().getBoolean(REPLACE_KICK_ON_LOGIN)) {
+		if (eventConnect != 0 || foundPlayer->isLoading || !g_configManager().getBoolean(REPLACE_KICK_ON_LOGIN)) {
 			// Already trying to connect
 			disconnectClient("You are already logged in.");
 			return;
@@ -567,6 +560,48 @@ void ProtocolGame::login(const std::string &name, uint32_t accountId, OperatingS
 	sendBosstiaryCooldownTimer();
 }
 
+void ProtocolGame::finishLogin(Player* loadingPlayer, const std::shared_ptr<DBPrefetchedResults> &prefetched, OperatingSystem_t operatingSystem) {
+	loadingPlayer->isLoading = false;
+	if (player != loadingPlayer || isConnectionExpired()) {
+		// The client left while its character was being fetched
+		g_game().removePlayerUniqueLogin(loadingPlayer);
+		loadingPlayer->decrementReferenceCounter();
+		return;
+	}
+
+	// From here on the reference held by this protocol keeps the player alive
+	loadingPlayer->decrementReferenceCounter();
+
+	bool loaded;
+	{
+		DBPrefetchScope prefetchScope(*prefetched);
+		loaded = IOLoginData::loadPlayerById(player, player->getGUID(), false);
+	}
+
+	if (!loaded) {
+		g_game().removePlayerUniqueLogin(player);
+		disconnectClient("Your character could not be loaded.");
+		g_logger().warn("Player {} could not be loaded", player->getName());
+		return;
+	}
+
+	player->setOperatingSystem(operatingSystem);
+
+	if (!g_game().placeCreature(player, player->getLoginPosition()) && !g_game().placeCreature(player, player->getTemplePosition(), false, true)) {
+		g_game().removePlayerUniqueLogin(player);
+		disconnectClient("Temple position is wrong. Please, contact the administrator.");
+		g_logger().warn("Player {} temple position is wrong", player->getName());
+		return;
+	}
+
+	player->lastIP = player->getIP();
+	player->lastLoginSaved = std::max<time_t>(time(nullptr), player->lastLoginSaved + 1);
+	acceptPackets = true;
+
+	OutputMessagePool::getInstance().addProtocolToAutosend(shared_from_this());
+	sendBosstiaryCooldownTimer();
+}
+
 void ProtocolGame::connect(const std::string &playerName, OperatingSystem_t operatingSystem) {
 	eventConnect = 0;
 
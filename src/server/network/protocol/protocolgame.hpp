@@ -25,6 +25,7 @@ class ProtocolGame;
 class PreySlot;
 class TaskHuntingSlot;
 class TaskHuntingOption;
+class DBPrefetchedResults;
 using ProtocolGame_ptr = std::shared_ptr<ProtocolGame>;
 
 struct TextMessage {
@@ -77,6 +78,7 @@ private:
 	ProtocolGame_ptr getThis() {
 		return std::static_pointer_cast<ProtocolGame>(shared_from_this());
 	}
+	void finishLogin(Player* loadingPlayer, const std::shared_ptr<DBPrefetchedResults> &prefetched, OperatingSystem_t operatingSystem);
 	void connect(const std::string &playerName, OperatingSystem_t operatingSystem);
 	void disconnectClient(const std::string &message) const;
 	void writeToOutputBuffer(const NetworkMessage &msg);
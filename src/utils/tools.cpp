@@ -271,6 +271,22 @@ std::string asUpperCaseString(std::string source) {
 	return source;
 }
 
+size_t CaseInsensitiveHash::operator()(std::string_view str) const {
+	// FNV-1a over the lowercased bytes
+	uint64_t hash = 14695981039346656037ULL;
+	for (const char c : str) {
+		hash ^= static_cast<uint64_t>(std::tolower(static_cast<unsigned char>(c)));
+		hash *= 1099511628211ULL;
+	}
+	return static_cast<size_t>(hash);
+}
+
+bool CaseInsensitiveEqual::operator()(std::string_view lhs, std::string_view rhs) const {
+	return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin(), [](char a, char b) {
+		return std::tolower(static_cast<unsigned char>(a)) == std::tolower(static_cast<unsigned char>(b));
+	});
+}
+
 std::string toCamelCase(const std::string &str) {
 	std::string result;
 	bool capitalizeNext = false;
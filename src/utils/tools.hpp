@@ -29,6 +29,23 @@ void toLowerCaseString(std::string &source);
 std::string asLowerCaseString(std::string source);
 std::string asUpperCaseString(std::string source);
 
+/**
+ * Hash and equality for maps keyed by names that compare case-insensitively,
+ * both are transparent so lookups by std::string_view do not build a lowercase copy.
+ */
+struct CaseInsensitiveHash {
+	using is_transparent = void;
+	size_t operator()(std::string_view str) const;
+};
+
+struct CaseInsensitiveEqual {
+	using is_transparent = void;
+	bool operator()(std::string_view lhs, std::string_view rhs) const;
+};
+
+template <typename T>
+using CaseInsensitiveMap = phmap::flat_hash_map<std::string, T, CaseInsensitiveHash, CaseInsensitiveEqual>;
+
 std::string toCamelCase(const std::string &str);
 std::string toPascalCase(const std::string &str);
 std::string toSnakeCase(const std::string &str);
@@ -0,0 +1,145 @@
+/**
+* Canary - A free and open-source MMORPG server emulator
+* Copyright (©) 2019-2023 OpenTibiaBR <opentibiabr@outlook.com>
+* Repository: https://github.com/opentibiabr/canary
+* License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+* Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+* Website: https://docs.opentibiabr.com/
+*/
+#include <boost/ut.hpp>
+#include "pch.hpp"
+#include "lib/thread/task.hpp"
+
+using namespace boost::ut;
+
+namespace {
+	// Counts every plain heap allocation of the calling thread, so the
+	// wrapping Task replaced can be measured the same way as Task itself
+	thread_local uint64_t threadAllocations = 0;
+
+	// What the dispatcher did before Task: a shared Task holding a std::function
+	struct LegacyTask {
+		explicit LegacyTask(std::function<void(void)> &&f) :
+			func(std::move(f)) { }
+
+		void operator()() {
+			func();
+		}
+
+		uint32_t delay = 0;
+		uint64_t eventId = 0;
+		std::function<void(void)> func;
+	};
+
+	template <typename MakeTask>
+	double allocationsPerTask(size_t taskCount, MakeTask &&makeTask) {
+		const uint64_t before = threadAllocations;
+		for (size_t i = 0; i < taskCount; ++i) {
+			makeTask(i);
+		}
+		return static_cast<double>(threadAllocations - before) / taskCount;
+	}
+}
+
+void* operator new(size_t size) {
+	++threadAllocations;
+	if (void* ptr = std::malloc(size == 0 ? 1 : size)) {
+		return ptr;
+	}
+	throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+	std::free(ptr);
+}
+
+suite<"lib"> taskTest = [] {
+	test("Task runs its callable and keeps the scheduling data") = [] {
+		int calls = 0;
+		Task task([&calls] { ++calls; }, 150);
+		task.setEventId(7);
+		task();
+
+		expect(eq(1, calls));
+		expect(eq(150u, task.getDelay()));
+		expect(eq(uint64_t { 7 }, task.getEventId()));
+	};
+
+	test("Task move leaves the source empty") = [] {
+		int calls = 0;
+		Task source([&calls] { ++calls; });
+		Task destination = std::move(source);
+		destination();
+
+		expect(!static_cast<bool>(source));
+		expect(static_cast<bool>(destination));
+		expect(eq(1, calls));
+	};
+
+	test("Task releases captured state exactly once") = [] {
+		auto counter = std::make_shared<int>(0);
+		{
+			Task task([counter] { ++*counter; });
+			Task moved = std::move(task);
+			expect(eq(2, counter.use_count()));
+		}
+		expect(eq(1, counter.use_count()));
+	};
+
+	test("Task does not allocate for small callables") = [] {
+		constexpr size_t taskCount = 100000;
+		const uint64_t allocationsBefore = TaskPool::getHeapAllocations();
+		uint64_t sum = 0;
+		for (size_t i = 0; i < taskCount; ++i) {
+			Task task([&sum, i, offsets = std::array<uint16_t, 4> { 1, 2, 3, 4 }] { sum += i + offsets[0]; });
+			task();
+		}
+		const uint64_t allocations = TaskPool::getHeapAllocations() - allocationsBefore;
+
+		log << fmt::format("small callables: {} allocations per task", static_cast<double>(allocations) / taskCount);
+		expect(eq(uint64_t { 0 }, allocations));
+	};
+
+	test("Task reuses pooled blocks for big callables") = [] {
+		constexpr size_t taskCount = 100000;
+		std::array<char, 128> payload {};
+		const uint64_t allocationsBefore = TaskPool::getHeapAllocations();
+		for (size_t i = 0; i < taskCount; ++i) {
+			Task task([payload]() mutable { payload[0]++; });
+			task();
+		}
+		const uint64_t allocations = TaskPool::getHeapAllocations() - allocationsBefore;
+
+		log << fmt::format("big callables: {} allocations per task", static_cast<double>(allocations) / taskCount);
+		expect(allocations <= 1u);
+	};
+
+	test("Task allocates less than the shared std::function it replaced") = [] {
+		constexpr size_t taskCount = 100000;
+		uint64_t sum = 0;
+		const auto small = [&sum, offsets = std::array<uint16_t, 4> { 1, 2, 3, 4 }](size_t i) {
+			return [&sum, i, offsets] { sum += i + offsets[0]; };
+		};
+		std::array<char, 128> payload {};
+		const auto big = [&payload](size_t) {
+			return [payload]() mutable { payload[0]++; };
+		};
+
+		const double legacySmall = allocationsPerTask(taskCount, [&](size_t i) { (*std::make_shared<LegacyTask>(small(i)))(); });
+		const double taskSmall = allocationsPerTask(taskCount, [&](size_t i) { Task(small(i))(); });
+		const double legacyBig = allocationsPerTask(taskCount, [&](size_t i) { (*std::make_shared<LegacyTask>(big(i)))(); });
+		const double taskBig = allocationsPerTask(taskCount, [&](size_t i) { Task(big(i))(); });
+
+		log << fmt::format("small callables: {} allocations per task before, {} now", legacySmall, taskSmall);
+		log << fmt::format("big callables: {} allocations per task before, {} now", legacyBig, taskBig);
+		// The shared block at least, the std::function as well where its inline buffer is below 24 bytes
+		expect(ge(legacySmall, 1.0));
+		expect(eq(0.0, taskSmall));
+		expect(ge(legacyBig, 2.0));
+		expect(lt(taskBig, 0.001));
+	};
+};
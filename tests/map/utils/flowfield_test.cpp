@@ -0,0 +1,102 @@
+/**
+* Canary - A free and open-source MMORPG server emulator
+* Copyright (©) 2019-2023 OpenTibiaBR <opentibiabr@outlook.com>
+* Repository: https://github.com/opentibiabr/canary
+* License: https://github.com/opentibiabr/canary/blob/main/LICENSE
+* Contributors: https://github.com/opentibiabr/canary/graphs/contributors
+* Website: https://docs.opentibiabr.com/
+*/
+#include <boost/ut.hpp>
+#include "pch.hpp"
+#include "map/utils/flowfield.hpp"
+
+using namespace boost::ut;
+
+suite<"map"> flowFieldTest = [] {
+	constexpr int32_t radius = FlowField::FLOW_FIELD_RADIUS;
+	const Position target(100, 100, 7);
+
+	const auto at = [&target](int32_t dx, int32_t dy) {
+		return Position(target.x + dx, target.y + dy, target.z);
+	};
+
+	// Open ground with a wall two tiles west of the target, from three tiles north to three tiles south of it
+	const auto buildWalled = [&target] {
+		FlowField::WalkableGrid walkable;
+		walkable.fill(true);
+		for (int32_t dy = -3; dy <= 3; ++dy) {
+			walkable[(dy + radius) * FlowField::FLOW_FIELD_SIZE + (-2 + radius)] = false;
+		}
+
+		FlowField field;
+		field.build(target, walkable);
+		return field;
+	};
+
+	const auto walkAnywhere = [](const Position &) {
+		return true;
+	};
+
+	test("FlowField costs open ground by step type") = [&] {
+		FlowField::WalkableGrid walkable;
+		walkable.fill(true);
+		FlowField field;
+		field.build(target, walkable);
+
+		expect(field.isBuiltFor(target));
+		expect(eq(FlowField::UNREACHABLE, field.getCost(target)));
+		expect(eq(uint16_t { 0 }, field.getCost(at(1, 1))));
+		expect(eq(uint16_t { MAP_NORMALWALKCOST }, field.getCost(at(2, 0))));
+		// Two straight steps are cheaper than a diagonal one
+		expect(eq(uint16_t { 2 * MAP_NORMALWALKCOST }, field.getCost(at(2, 2))));
+		expect(eq(FlowField::UNREACHABLE, field.getCost(at(radius + 1, 0))));
+	};
+
+	test("FlowField costs the way around an obstacle") = [&] {
+		const FlowField field = buildWalled();
+
+		expect(eq(uint16_t { 0 }, field.getCost(at(-1, 0))));
+		expect(eq(FlowField::UNREACHABLE, field.getCost(at(-2, 0))));
+		// Four steps north past the wall, two east and three south to the nearest tile next to the target
+		expect(eq(uint16_t { 9 * MAP_NORMALWALKCOST }, field.getCost(at(-3, 0))));
+	};
+
+	test("FlowField descends around an obstacle to the target") = [&] {
+		const FlowField field = buildWalled();
+
+		Position pos = at(-3, 0);
+		Position nextPos;
+		expect(eq(DIRECTION_SOUTH, field.getNextStep(pos, walkAnywhere, nextPos)));
+		expect(nextPos == at(-3, 1));
+
+		size_t steps = 0;
+		while (field.getCost(pos) != 0 && steps < 20) {
+			const uint16_t cost = field.getCost(pos);
+			expect(fatal(field.getNextStep(pos, walkAnywhere, nextPos) != DIRECTION_NONE));
+			expect(field.getCost(nextPos) < cost);
+			expect(nextPos.x != target.x - 2 || nextPos.y < target.y - 3 || nextPos.y > target.y + 3) << "stepped into the wall";
+			pos = nextPos;
+			++steps;
+		}
+		expect(eq(uint16_t { 0 }, field.getCost(pos)));
+		// The descent may cut corners diagonally, never more steps than the straight way
+		expect(steps <= size_t { 9 });
+	};
+
+	test("FlowField descent skips steps the follower cannot walk") = [&] {
+		const FlowField field = buildWalled();
+		const Position south = at(-3, 1);
+
+		Position nextPos;
+		const auto notSouth = [&south](const Position &pos) {
+			return pos != south;
+		};
+		expect(eq(DIRECTION_NORTH, field.getNextStep(at(-3, 0), notSouth, nextPos)));
+		expect(nextPos == at(-3, -1));
+
+		const auto nowhere = [](const Position &) {
+			return false;
+		};
+		expect(eq(DIRECTION_NONE, field.getNextStep(at(-3, 0), nowhere, nextPos)));
+	};
+};
@@ -30,3 +30,22 @@ suite<"utils"> replaceStringTest = [] {
 		};
 	}
 };
+
+suite<"utils"> caseInsensitiveMapTest = [] {
+	test("CaseInsensitiveHash and CaseInsensitiveEqual ignore case") = [] {
+		expect(eq(CaseInsensitiveHash {}("Knight Name"), CaseInsensitiveHash {}("kNIGHT nAME")));
+		expect(CaseInsensitiveEqual {}("Knight Name", "kNIGHT nAME"));
+		expect(!CaseInsensitiveEqual {}("Knight Name", "Knight Names"));
+		expect(!CaseInsensitiveEqual {}("Knight", "Knigth"));
+	};
+
+	test("CaseInsensitiveMap finds keys by string_view in any case") = [] {
+		CaseInsensitiveMap<int> map;
+		map["Player Name"] = 1;
+		expect(eq(1, map.find(std::string_view("player name"))->second));
+		expect(map.find(std::string_view("PLAYER NAME")) != map.end());
+		expect(map.find(std::string_view("player")) == map.end());
+		expect(eq(size_t { 1 }, map.erase(std::string_view("pLaYeR nAmE"))));
+		expect(map.empty());
+	};
+};